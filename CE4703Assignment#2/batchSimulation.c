@@ -0,0 +1,596 @@
+/**
+ * @file batchSimulation.c
+ * @brief Lockstep engine playing many silent games side by side
+ *
+ * @author Oluwatunmise Adegbola
+ * @date 17 October 2026
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BATCH_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BATCH_SSE2 1
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "batchSimulation.h"
+#include "rng.h"
+#include "zobrist.h"
+
+#define BATCH_LANES 4	// slots are allocated in multiples of this
+#define MAX_BATCH_PACKS 65535	// per-type counts are 16 bit
+#define MAX_DECK_BYTES (32 * 1024 * 1024)	// bound on hidden + played storage
+#define NO_CARD 0xFF
+
+
+/**
+ * @brief Struct-of-arrays state of all the games in flight
+ */
+struct BatchEngine {
+	int numPacks;	// packs per game
+	int numPlayers;	// players per game
+	int width;	// number of game slots, a multiple of BATCH_LANES
+	int deckCards;	// cards in a full deck, numPacks * CARDS_PER_PACK
+
+	uint64_t* hands;	// [player][slot] bit c set if card type c is held
+	uint16_t* counts;	// [player][slot][card type] copies held
+	int* handSizes;	// [player][slot] cards held
+	uint64_t* matchMasks;	// [slot] cards playable on the current card
+	uint8_t* current;	// [slot] current card
+	uint8_t* live;	// [slot] set if a game is being played in the slot
+	int* playSlots;	// slots whose seat to move plays this turn
+	int* drawSlots;	// slots whose seat to move draws this turn
+
+	uint8_t* hidden;	// [slot][deckCards] hidden deck, top at hiddenTop
+	int* hiddenTop;	// [slot] position of the top card
+	int* hiddenEnd;	// [slot] one past the bottom card
+	uint8_t* played;	// [slot][deckCards] played deck, top card last
+	int* playedSize;	// [slot] cards in the played deck
+
+	Rng* rngs;	// [slot] the hidden deck's random stream
+	long long* gameIndex;	// [slot] game being played, -1 for a free slot
+	int* turns;	// [slot]
+	int* draws;	// [slot]
+	int* reshuffles;	// [slot]
+	uint8_t* outcomes;	// [slot] stalemate or cycle found during the turn, OUTCOME_NONE otherwise
+	uint64_t* positions;	// [slot][CYCLE_HISTORY] hashes after the last reshuffles
+	int maxTurns;	// turn cap, 0 for none
+	int maxRepeats;	// cycle threshold, 0 for none
+};
+
+
+/**
+ * @brief Index of the lowest set bit of a non-zero mask
+ */
+static inline int lowestBit(uint64_t mask)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, mask);
+	return (int)index;
+#else
+	return __builtin_ctzll(mask);
+#endif
+}
+
+
+/**
+ * @brief Sorts the live slots into those that can play and those that must draw
+ *
+ * The vector part tests hand & match mask against zero for several slots
+ * at once; the slot lists are then appended to without branching, so the
+ * play and draw loops that follow each run one predictable path.
+ *
+ * @param engine Engine
+ * @param seat Seat to move
+ * @param numPlays Where to store the number of slots in playSlots
+ * @return Number of slots in drawSlots
+ */
+static int splitSlots(BatchEngine* engine, int seat, int* numPlays)
+{
+	const uint64_t* hands = engine -> hands + (size_t)seat * engine -> width;
+	const uint64_t* masks = engine -> matchMasks;
+	const uint8_t* live = engine -> live;
+	int plays = 0;
+	int draws = 0;
+
+	for (int k = 0; k < engine -> width; k += BATCH_LANES) {
+		int empty;	// bit i set if slot k + i has nothing to play
+#if BATCH_AVX2
+		__m256i both = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(hands + k)),
+			_mm256_loadu_si256((const __m256i*)(masks + k)));
+		empty = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(both, _mm256_setzero_si256())));
+#elif BATCH_SSE2
+		// SSE2 has no 64 bit compare: a lane is zero if both of its 32 bit halves are
+		empty = 0;
+		for (int half = 0; half < BATCH_LANES; half += 2) {
+			__m128i both = _mm_and_si128(_mm_loadu_si128((const __m128i*)(hands + k + half)),
+				_mm_loadu_si128((const __m128i*)(masks + k + half)));
+			__m128i halves = _mm_cmpeq_epi32(both, _mm_setzero_si128());
+			__m128i lanes = _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+			empty |= _mm_movemask_pd(_mm_castsi128_pd(lanes)) << half;
+		}
+#else
+		empty = 0;
+		for (int lane = 0; lane < BATCH_LANES; lane++) {
+			empty |= ((hands[k + lane] & masks[k + lane]) == 0) << lane;
+		}
+#endif
+		for (int lane = 0; lane < BATCH_LANES; lane++) {
+			int slot = k + lane;
+			int draw = (empty >> lane) & 1;
+			engine -> playSlots[plays] = slot;
+			engine -> drawSlots[draws] = slot;
+			plays += live[slot] & (draw ^ 1);
+			draws += live[slot] & draw;
+		}
+	}
+
+	*numPlays = plays;
+	return draws;
+}
+
+
+/**
+ * @brief Name of the instruction set used for match detection
+ */
+const char* batchSimdName(void)
+{
+#if BATCH_AVX2
+	return "avx2";
+#elif BATCH_SSE2
+	return "sse2";
+#else
+	return "scalar";
+#endif
+}
+
+
+/**
+ * @brief Fisher-Yates shuffle, the same steps shuffleDeck() takes
+ */
+static void shuffleCards(uint8_t* cards, int size, Rng* rng)
+{
+	for (int i = size - 1; i > 0; i--) {
+		int j = (int)randomBelow(rng, (uint32_t)i + 1);
+		uint8_t temp = cards[i];
+		cards[i] = cards[j];
+		cards[j] = temp;
+	}
+}
+
+
+/**
+ * @brief Adds a card to a player's hand in one slot
+ */
+static inline void addToHand(BatchEngine* engine, int player, int slot, uint8_t card)
+{
+	int at = player * engine -> width + slot;
+	engine -> counts[(size_t)at * NUM_CARD_TYPES + card]++;
+	engine -> hands[at] |= 1ULL << card;
+	engine -> handSizes[at]++;
+}
+
+
+/**
+ * @brief Removes a card from a player's hand in one slot
+ */
+static inline void removeFromHand(BatchEngine* engine, int player, int slot, uint8_t card)
+{
+	int at = player * engine -> width + slot;
+	if (--engine -> counts[(size_t)at * NUM_CARD_TYPES + card] == 0) {
+		engine -> hands[at] &= ~(1ULL << card);
+	}
+	engine -> handSizes[at]--;
+}
+
+
+/**
+ * @brief Takes the top card of a slot's hidden deck
+ *
+ * @return The card, or NO_CARD if the hidden deck is empty
+ */
+static inline uint8_t drawHidden(BatchEngine* engine, int slot)
+{
+	if (engine -> hiddenTop[slot] == engine -> hiddenEnd[slot]) {
+		return NO_CARD;
+	}
+	return engine -> hidden[(size_t)slot * engine -> deckCards + engine -> hiddenTop[slot]++];
+}
+
+
+/**
+ * @brief Zobrist hash of a slot's position right after a reshuffle
+ *
+ * Computed from scratch the way rehashGame() does, with the played deck
+ * down to its top card; reshuffles are rare, so nothing is kept up to
+ * date between them.
+ */
+static uint64_t hashReshuffledSlot(const BatchEngine* engine, int slot, int seat)
+{
+	const uint8_t* hidden = engine -> hidden + (size_t)slot * engine -> deckCards;
+	uint64_t hiddenSum = 0;
+	for (int i = engine -> hiddenTop[slot]; i < engine -> hiddenEnd[slot]; i++) {
+		hiddenSum += zobristCardKey(unpackCard(hidden[i]));
+	}
+
+	Card current = unpackCard(engine -> current[slot]);
+	uint64_t hash = zobristCurrentKey(current) + zobristPlayerKey(seat)
+		+ zobristPileKey(ZOBRIST_HIDDEN) * hiddenSum
+		+ zobristPileKey(ZOBRIST_PLAYED) * zobristCardKey(current);
+
+	for (int p = 0; p < engine -> numPlayers; p++) {
+		const uint16_t* counts = engine -> counts + (size_t)(p * engine -> width + slot) * NUM_CARD_TYPES;
+		uint64_t handSum = 0;
+		for (int t = 0; t < NUM_CARD_TYPES; t++) {
+			handSum += counts[t] * zobristCardKey(unpackCard((PackedCard)t));
+		}
+		hash += zobristPileKey(ZOBRIST_HAND(p)) * handSum;
+	}
+	return hash;
+}
+
+
+/**
+ * @brief Same as reshuffleHiddenDeck(): all played cards but the top one
+ * go to the hidden deck in top-to-bottom order, then it is shuffled, and
+ * the position is checked for a cycle
+ */
+static void reshuffleSlot(BatchEngine* engine, int slot, int seat)
+{
+	int size = engine -> playedSize[slot];
+	if (size <= 1) {
+		return;
+	}
+
+	uint8_t* played = engine -> played + (size_t)slot * engine -> deckCards;
+	uint8_t* hidden = engine -> hidden + (size_t)slot * engine -> deckCards;
+	for (int i = 0; i < size - 1; i++) {
+		hidden[i] = played[size - 2 - i];
+	}
+	played[0] = played[size - 1];
+	engine -> playedSize[slot] = 1;
+	engine -> hiddenTop[slot] = 0;
+	engine -> hiddenEnd[slot] = size - 1;
+
+	shuffleCards(hidden, size - 1, &engine -> rngs[slot]);
+	engine -> reshuffles[slot]++;
+
+	if (engine -> maxRepeats > 0
+		&& recordPosition(engine -> positions + (size_t)slot * CYCLE_HISTORY, engine -> reshuffles[slot] - 1,
+			hashReshuffledSlot(engine, slot, seat)) >= engine -> maxRepeats) {
+		engine -> outcomes[slot] = OUTCOME_CYCLE;
+	}
+}
+
+
+/**
+ * @brief Sets up game number game in a slot: shuffle, deal, first card
+ */
+static void startGame(BatchEngine* engine, int slot, unsigned long long seed, long long game)
+{
+	uint8_t* hidden = engine -> hidden + (size_t)slot * engine -> deckCards;
+
+	seedRng(&engine -> rngs[slot], (uint64_t)(seed + (unsigned long long)game));
+	for (int i = 0; i < engine -> deckCards; i++) {
+		hidden[i] = (uint8_t)(i % NUM_CARD_TYPES);
+	}
+	shuffleCards(hidden, engine -> deckCards, &engine -> rngs[slot]);
+	engine -> hiddenTop[slot] = 0;
+	engine -> hiddenEnd[slot] = engine -> deckCards;
+	engine -> playedSize[slot] = 0;
+
+	for (int p = 0; p < engine -> numPlayers; p++) {
+		int at = p * engine -> width + slot;
+		engine -> hands[at] = 0;
+		engine -> handSizes[at] = 0;
+		memset(engine -> counts + (size_t)at * NUM_CARD_TYPES, 0, NUM_CARD_TYPES * sizeof(uint16_t));
+	}
+
+	for (int i = 0; i < INITIAL_HAND_SIZE; i++) {
+		for (int p = 0; p < engine -> numPlayers; p++) {
+			uint8_t card = drawHidden(engine, slot);
+			if (card != NO_CARD) {
+				addToHand(engine, p, slot, card);
+			}
+		}
+	}
+
+	// createBatchEngine() checked that the deck covers the deal and a first card
+	uint8_t first = drawHidden(engine, slot);
+	engine -> current[slot] = first;
+	engine -> played[(size_t)slot * engine -> deckCards] = first;
+	engine -> playedSize[slot] = 1;
+	engine -> matchMasks[slot] = cardMatchMasks[first];
+
+	engine -> gameIndex[slot] = game;
+	engine -> live[slot] = 1;
+	engine -> turns[slot] = 0;
+	engine -> draws[slot] = 0;
+	engine -> reshuffles[slot] = 0;
+	engine -> outcomes[slot] = OUTCOME_NONE;
+}
+
+
+/**
+ * @brief Seat plays the first matching card of its sorted hand in a slot
+ */
+static inline void playSlot(BatchEngine* engine, int slot, int seat)
+{
+	int at = seat * engine -> width + slot;
+	uint8_t card = (uint8_t)lowestBit(engine -> hands[at] & engine -> matchMasks[slot]);
+
+	removeFromHand(engine, seat, slot, card);
+	engine -> current[slot] = card;
+	engine -> matchMasks[slot] = cardMatchMasks[card];
+	engine -> played[(size_t)slot * engine -> deckCards + engine -> playedSize[slot]++] = card;
+}
+
+
+/**
+ * @brief Seat draws a card in a slot, reshuffling first if needed
+ *
+ * Like drawCardForPlayer(), a turn with nothing to draw is a stalemate
+ * if no hand holds a match for the current card.
+ */
+static inline void drawSlot(BatchEngine* engine, int slot, int seat)
+{
+	if (engine -> hiddenTop[slot] == engine -> hiddenEnd[slot]) {
+		reshuffleSlot(engine, slot, seat);
+	}
+
+	uint8_t card = drawHidden(engine, slot);
+	if (card != NO_CARD) {
+		addToHand(engine, seat, slot, card);
+		engine -> draws[slot]++;
+		return;
+	}
+
+	for (int p = 0; p < engine -> numPlayers; p++) {
+		if (engine -> hands[p * engine -> width + slot] & engine -> matchMasks[slot]) {
+			return;
+		}
+	}
+	engine -> outcomes[slot] = OUTCOME_STALEMATE;
+}
+
+
+/**
+ * @brief Reports a finished game and frees its slot
+ */
+static void finishGame(BatchEngine* engine, int slot, int seat, GameOutcome outcome, long long first,
+	GameResult* results, BatchStats* stats)
+{
+	GameResult result;
+	result.outcome = outcome;
+	result.winner = outcome == OUTCOME_WIN ? seat : -1;
+	result.turns = engine -> turns[slot];
+	result.draws = engine -> draws[slot];
+	result.reshuffles = engine -> reshuffles[slot];
+
+	addGameResult(stats, &result);
+	if (results) {
+		results[engine -> gameIndex[slot] - first] = result;
+	}
+
+	engine -> gameIndex[slot] = -1;
+	engine -> live[slot] = 0;
+}
+
+
+/**
+ * @brief Allocates a zeroed array of count elements
+ */
+static void* allocArray(size_t count, size_t size)
+{
+	return calloc(count ? count : 1, size);
+}
+
+
+/**
+ * @brief Creates an engine, see batchSimulation.h
+ */
+BatchEngine* createBatchEngine(int numPacks, int numPlayers, int width)
+{
+	if (numPacks <= 0 || numPacks > MAX_BATCH_PACKS || numPlayers < MIN_PLAYERS || numPlayers > MAX_PLAYERS
+		|| numPacks * CARDS_PER_PACK < numPlayers * INITIAL_HAND_SIZE + 1) {
+		return NULL;
+	}
+	if (width <= 0) {
+		width = BATCH_DEFAULT_WIDTH;
+	}
+
+	// hidden and played decks take 2 bytes per card per slot
+	long long slotBytes = 2LL * numPacks * CARDS_PER_PACK;
+	if (width > MAX_DECK_BYTES / slotBytes) {
+		width = (int)(MAX_DECK_BYTES / slotBytes);
+	}
+	width = (width + BATCH_LANES - 1) / BATCH_LANES * BATCH_LANES;
+	if (width < BATCH_LANES) {
+		width = BATCH_LANES;
+	}
+
+	BatchEngine* engine = calloc(1, sizeof(BatchEngine));
+	if (!engine) {
+		return NULL;
+	}
+
+	size_t slots = (size_t)width;
+	size_t seats = (size_t)numPlayers * slots;
+	engine -> numPacks = numPacks;
+	engine -> numPlayers = numPlayers;
+	engine -> width = width;
+	engine -> deckCards = numPacks * CARDS_PER_PACK;
+
+	engine -> hands = allocArray(seats, sizeof(uint64_t));
+	engine -> counts = allocArray(seats * NUM_CARD_TYPES, sizeof(uint16_t));
+	engine -> handSizes = allocArray(seats, sizeof(int));
+	engine -> matchMasks = allocArray(slots, sizeof(uint64_t));
+	engine -> current = allocArray(slots, sizeof(uint8_t));
+	engine -> live = allocArray(slots, sizeof(uint8_t));
+	engine -> playSlots = allocArray(slots, sizeof(int));
+	engine -> drawSlots = allocArray(slots, sizeof(int));
+	engine -> hidden = allocArray(slots * (size_t)engine -> deckCards, sizeof(uint8_t));
+	engine -> hiddenTop = allocArray(slots, sizeof(int));
+	engine -> hiddenEnd = allocArray(slots, sizeof(int));
+	engine -> played = allocArray(slots * (size_t)engine -> deckCards, sizeof(uint8_t));
+	engine -> playedSize = allocArray(slots, sizeof(int));
+	engine -> rngs = allocArray(slots, sizeof(Rng));
+	engine -> gameIndex = allocArray(slots, sizeof(long long));
+	engine -> turns = allocArray(slots, sizeof(int));
+	engine -> draws = allocArray(slots, sizeof(int));
+	engine -> reshuffles = allocArray(slots, sizeof(int));
+	engine -> outcomes = allocArray(slots, sizeof(uint8_t));
+	engine -> positions = allocArray(slots * CYCLE_HISTORY, sizeof(uint64_t));
+	engine -> maxTurns = DEFAULT_MAX_TURNS;
+	engine -> maxRepeats = DEFAULT_MAX_REPEATS;
+
+	if (!engine -> hands || !engine -> counts || !engine -> handSizes || !engine -> matchMasks
+		|| !engine -> current || !engine -> live || !engine -> playSlots
+		|| !engine -> drawSlots || !engine -> hidden || !engine -> hiddenTop
+		|| !engine -> hiddenEnd || !engine -> played || !engine -> playedSize || !engine -> rngs
+		|| !engine -> gameIndex || !engine -> turns || !engine -> draws || !engine -> reshuffles
+		|| !engine -> outcomes || !engine -> positions) {
+		freeBatchEngine(engine);
+		return NULL;
+	}
+
+	return engine;
+}
+
+
+/**
+ * @brief Frees an engine and all its arrays
+ */
+void freeBatchEngine(BatchEngine* engine)
+{
+	if (!engine) {
+		return;
+	}
+
+	free(engine -> hands);
+	free(engine -> counts);
+	free(engine -> handSizes);
+	free(engine -> matchMasks);
+	free(engine -> current);
+	free(engine -> live);
+	free(engine -> playSlots);
+	free(engine -> drawSlots);
+	free(engine -> hidden);
+	free(engine -> hiddenTop);
+	free(engine -> hiddenEnd);
+	free(engine -> played);
+	free(engine -> playedSize);
+	free(engine -> rngs);
+	free(engine -> gameIndex);
+	free(engine -> turns);
+	free(engine -> draws);
+	free(engine -> reshuffles);
+	free(engine -> outcomes);
+	free(engine -> positions);
+	free(engine);
+}
+
+
+/**
+ * @brief Sets the turn cap and cycle threshold, see batchSimulation.h
+ */
+void setBatchLimits(BatchEngine* engine, int maxTurns, int maxRepeats)
+{
+	engine -> maxTurns = maxTurns > 0 ? maxTurns : 0;
+	engine -> maxRepeats = maxRepeats > 0 ? maxRepeats : 0;
+}
+
+
+/**
+ * @brief Plays a range of games, refilling slots as games finish
+ *
+ * Each pass is one turn of the same seat in every live game: the slots
+ * are split into players and drawers in one vector sweep, then each list
+ * is worked through. Free slots are only refilled when seat 0 is about
+ * to move, which keeps every live game on the same seat.
+ */
+long long runBatchGames(BatchEngine* engine, unsigned long long seed, long long first,
+	long long count, GameResult* results, BatchStats* stats)
+{
+	int width = engine -> width;
+	long long next = first;
+	long long end = first + count;
+	long long played = 0;
+	int live = 0;
+	int seat = 0;
+
+	for (int k = 0; k < width; k++) {
+		engine -> gameIndex[k] = -1;
+		engine -> live[k] = 0;
+	}
+
+	for (;;) {
+		if (seat == 0) {
+			for (int k = 0; k < width && next < end; k++) {
+				if (!engine -> live[k]) {
+					startGame(engine, k, seed, next++);
+					live++;
+				}
+			}
+		}
+		if (live == 0) {
+			if (next >= end) {
+				break;
+			}
+			seat = 0;	// nothing in flight, so any seat can start the next games
+			continue;
+		}
+
+		int numPlays;
+		int numDraws = splitSlots(engine, seat, &numPlays);
+
+		for (int i = 0; i < numPlays; i++) {
+			int slot = engine -> playSlots[i];
+			engine -> turns[slot]++;
+			playSlot(engine, slot, seat);
+		}
+		for (int i = 0; i < numDraws; i++) {
+			int slot = engine -> drawSlots[i];
+			engine -> turns[slot]++;
+			drawSlot(engine, slot, seat);
+		}
+
+		// only the player who just played can have emptied their hand, and
+		// only a draw can find a stalemate or a cycle; then comes the turn cap
+		for (int i = 0; i < numPlays; i++) {
+			int slot = engine -> playSlots[i];
+			GameOutcome outcome = engine -> handSizes[seat * width + slot] == 0 ? OUTCOME_WIN
+				: engine -> turns[slot] == engine -> maxTurns ? OUTCOME_TURN_LIMIT : OUTCOME_NONE;
+			if (outcome != OUTCOME_NONE) {
+				finishGame(engine, slot, seat, outcome, first, results, stats);
+				live--;
+				played++;
+			}
+		}
+		for (int i = 0; i < numDraws; i++) {
+			int slot = engine -> drawSlots[i];
+			GameOutcome outcome = engine -> outcomes[slot] != OUTCOME_NONE ? (GameOutcome)engine -> outcomes[slot]
+				: engine -> turns[slot] == engine -> maxTurns ? OUTCOME_TURN_LIMIT : OUTCOME_NONE;
+			if (outcome != OUTCOME_NONE) {
+				finishGame(engine, slot, seat, outcome, first, results, stats);
+				live--;
+				played++;
+			}
+		}
+
+		if (++seat == engine -> numPlayers) {
+			seat = 0;
+		}
+	}
+
+	return played;
+}
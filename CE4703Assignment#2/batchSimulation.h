@@ -0,0 +1,90 @@
+/**
+ * @file batchSimulation.h
+ * @brief Lockstep engine playing many silent games side by side
+ *
+ * The engine keeps K games in struct-of-arrays form: per game and player
+ * a 52-bit mask of the card types held plus a count per card type, the
+ * match mask of each game's current card, and flat arrays for each
+ * game's hidden and played decks. All K games are advanced one turn at a
+ * time; since every game starts with seat 0 and seats take turns in the
+ * same order, the seat to move is the same in every live game, so the
+ * "can this player play?" test runs over K contiguous masks with SIMD
+ * (AVX2 when compiled for it, e.g. with the CARDGAME_AVX2 CMake option,
+ * otherwise SSE2, or a scalar loop). The card to play is the lowest set bit
+ * of hand & match mask, which is what findMatchingCard() picks from a
+ * sorted hand.
+ *
+ * The engine follows the same rules and random streams as the normal
+ * game functions, so game i played here with seed + i gives exactly the
+ * same GameResult as playGame() with that seed. A finished game's slot
+ * is refilled with the next game on the next turn where seat 0 moves.
+ * Stalemates, cycles and the turn cap end games the way
+ * checkGameOutcome() does, with the DEFAULT_MAX_TURNS and
+ * DEFAULT_MAX_REPEATS limits unless setBatchLimits() says otherwise.
+ *
+ * @author Oluwatunmise Adegbola
+ * @date 17 October 2026
+*/
+
+#ifndef BATCHSIMULATION_H
+#define BATCHSIMULATION_H
+
+#include "gameSimulation.h"
+
+#define BATCH_DEFAULT_WIDTH 512
+
+typedef struct BatchEngine BatchEngine;
+
+/**
+  * @brief Creates an engine for games with a given number of packs.
+  *
+  * @param numPacks Number of card packs per game (1 to 65535)
+  * @param numPlayers Number of players per game; the deck must cover the
+  *        deal and a first card, like initGameWithConfig() requires
+  * @param width Number of games played side by side, 0 for the default;
+  *        reduced for very large decks to bound the memory used
+  * @return New engine, or NULL on invalid arguments or memory failure
+*/
+BatchEngine* createBatchEngine(int numPacks, int numPlayers, int width);
+
+/**
+  * @brief Frees an engine.
+  *
+  * @param engine Engine to free, may be NULL
+*/
+void freeBatchEngine(BatchEngine* engine);
+
+/**
+  * @brief Sets the limits that stop a game without a winner.
+  *
+  * @param engine Engine to configure
+  * @param maxTurns Turn cap, 0 for none (GameConfig.maxTurns)
+  * @param maxRepeats Repeats of a reshuffle position that end the game as
+  *        a cycle, at least 2, or 0 to not look for cycles (GameConfig.maxRepeats)
+*/
+void setBatchLimits(BatchEngine* engine, int maxTurns, int maxRepeats);
+
+/**
+  * @brief Plays games first to first + count - 1 of a batch.
+  *
+  * Game g is seeded with seed + g.
+  *
+  * @param engine Engine to use
+  * @param seed Seed of game 0 of the batch
+  * @param first Index of the first game to play
+  * @param count Number of games to play
+  * @param results Array of count results (results[0] is game first), or NULL
+  * @param stats Totals the games are added to, cannot be NULL
+  * @return Number of games played
+*/
+long long runBatchGames(BatchEngine* engine, unsigned long long seed, long long first,
+	long long count, GameResult* results, BatchStats* stats);
+
+/**
+  * @brief Name of the instruction set used for match detection.
+  *
+  * @return "avx2", "sse2" or "scalar"
+*/
+const char* batchSimdName(void);
+
+#endif // !BATCHSIMULATION_H
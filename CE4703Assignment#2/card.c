@@ -4,7 +4,9 @@
  *
  * This file provides functions to convert Suit and Rank to
  * readable strings, a function to print a card, and a comparison
- * function that can be used when sorting cards.
+ * function that can be used when sorting cards. The name lookups and
+ * the comparison are table and arithmetic based, and the table of
+ * cards that can be played on each packed card lives here as well.
  * These helper functions are used by the deck module and
  * by the game logic.
  *
@@ -14,38 +16,46 @@
 
 #include <stdio.h>
 #include "card.h"
+#include "counters.h"
+
+/// Masks of all the cards of one suit, and of all the cards of one rank
+#define SUIT_BITS(s) (0x1FFFULL << (13 * (s)))
+#define RANK_BITS(r) (0x8004002001ULL << (r))
+#define MATCH_MASK(i) (SUIT_BITS((i) / 13) | RANK_BITS((i) % 13))
+#define MATCH_SUIT(s) \
+    MATCH_MASK(13 * (s) + 0), MATCH_MASK(13 * (s) + 1), MATCH_MASK(13 * (s) + 2), \
+    MATCH_MASK(13 * (s) + 3), MATCH_MASK(13 * (s) + 4), MATCH_MASK(13 * (s) + 5), \
+    MATCH_MASK(13 * (s) + 6), MATCH_MASK(13 * (s) + 7), MATCH_MASK(13 * (s) + 8), \
+    MATCH_MASK(13 * (s) + 9), MATCH_MASK(13 * (s) + 10), MATCH_MASK(13 * (s) + 11), \
+    MATCH_MASK(13 * (s) + 12)
+
+const uint64_t cardMatchMasks[NUM_CARD_TYPES] = {
+    MATCH_SUIT(0), MATCH_SUIT(1), MATCH_SUIT(2), MATCH_SUIT(3)
+};
+
+// Text labels indexed by suit, and by rank - TWO.
+static const char* const suitNames[] = { "Club", "Spade", "Heart", "Diamond" };
+static const char* const rankNames[] = {
+    "Two", "Three", "Four", "Five", "Six", "Seven", "Eight",
+    "Nine", "Ten", "Jack", "Queen", "King", "Ace"
+};
 
 const char* suitToString(Suit s)
 {
-    // Short text label for each suit.
-    switch (s) {
-    case CLUB:    return "Club";
-    case SPADE:   return "Spade";
-    case HEART:   return "Heart";
-    case DIAMOND: return "Diamond";
-    default:      return "UnknownSuit";
+    // One bounds check covers negative values too.
+    if ((unsigned)s >= sizeof(suitNames) / sizeof(suitNames[0])) {
+        return "UnknownSuit";
     }
+    return suitNames[s];
 }
 
 const char* rankToString(Rank r)
 {
-    // Short text label for each rank.
-    switch (r) {
-    case TWO:   return "Two";
-    case THREE: return "Three";
-    case FOUR:  return "Four";
-    case FIVE:  return "Five";
-    case SIX:   return "Six";
-    case SEVEN: return "Seven";
-    case EIGHT: return "Eight";
-    case NINE:  return "Nine";
-    case TEN:   return "Ten";
-    case JACK:  return "Jack";
-    case QUEEN: return "Queen";
-    case KING:  return "King";
-    case ACE:   return "Ace";
-    default:    return "UnknownRank";
+    unsigned index = (unsigned)r - TWO;
+    if (index >= sizeof(rankNames) / sizeof(rankNames[0])) {
+        return "UnknownRank";
     }
+    return rankNames[index];
 }
 
 void printCard(const Card* c)
@@ -62,6 +72,8 @@ void printCard(const Card* c)
 
 int compareCards(const Card* a, const Card* b)
 {
+    COUNT_OP(COUNTER_COMPARES);
+
     // Handle NULL pointers first (just in case).
     if (a == NULL || b == NULL) {
         if (a == b) {
@@ -75,11 +87,7 @@ int compareCards(const Card* a, const Card* b)
         }
     }
 
-    // First compare by suit (CLUB < SPADE < HEART < DIAMOND).
-    if (a->suit != b->suit) {
-        return (int)a->suit - (int)b->suit;
-    }
-
-    // If suits are equal, compare by rank (Two..Ace).
-    return (int)a->rank - (int)b->rank;
+    // Suit * 13 + rank orders by suit first (CLUB < SPADE < HEART < DIAMOND),
+    // then by rank (Two..Ace), the same order as the packed index.
+    return ((int)a->suit * 13 + (int)a->rank) - ((int)b->suit * 13 + (int)b->rank);
 }
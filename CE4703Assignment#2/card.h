@@ -15,6 +15,9 @@
 #ifndef CARD_H
 #define CARD_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
  /** @brief Enum for all four suits (Club, Spade, Heart, Diamond). */
 typedef enum {
     CLUB,
@@ -50,6 +53,91 @@ typedef struct {
     Rank rank; /**< Rank of the card. */
 } Card;
 
+/** @brief Number of distinct cards in one pack. */
+#define NUM_CARD_TYPES 52
+
+/**
+ * @brief A card packed into one byte.
+ *
+ * The value is the card's index 0-51, suit * 13 + (rank - TWO), so packed
+ * cards sort in the same order as compareCards(). Arrays of packed cards
+ * take an eighth of the memory of Card arrays.
+ */
+typedef uint8_t PackedCard;
+
+/**
+ * @brief Bit c of cardMatchMasks[p] is set if packed card c can be played
+ * on packed card p (same suit or same rank).
+ */
+extern const uint64_t cardMatchMasks[NUM_CARD_TYPES];
+
+/**
+ * @brief Checks that a card has one of the four suits and a rank from
+ * Two to Ace.
+ * @param c Card to check.
+ * @return true if the card can be packed.
+ */
+static inline bool isValidCard(Card c)
+{
+    return (int)c.suit >= CLUB && (int)c.suit <= DIAMOND
+        && (int)c.rank >= TWO && (int)c.rank <= ACE;
+}
+
+/**
+ * @brief Packs a card into its one-byte index.
+ *
+ * Other cards give an index outside 0-51 that must not be used with
+ * cardMatchMasks, check them with isValidCard() first.
+ *
+ * @param c Card with a valid suit and rank.
+ * @return Index 0-51.
+ */
+static inline PackedCard packCard(Card c)
+{
+    return (PackedCard)((int)c.suit * 13 + ((int)c.rank - TWO));
+}
+
+/**
+ * @brief Suit of a packed card.
+ */
+static inline Suit packedSuit(PackedCard p)
+{
+    return (Suit)(p / 13);
+}
+
+/**
+ * @brief Rank of a packed card.
+ */
+static inline Rank packedRank(PackedCard p)
+{
+    return (Rank)(p % 13 + TWO);
+}
+
+/**
+ * @brief Unpacks a one-byte index back into a card.
+ * @param p Index 0-51.
+ * @return The card.
+ */
+static inline Card unpackCard(PackedCard p)
+{
+    Card c = { packedSuit(p), packedRank(p) };
+    return c;
+}
+
+/**
+ * @brief Checks if a packed card can be played on another one.
+ *
+ * Both cards must be packed from valid cards, the index is not checked.
+ *
+ * @param card Card to play, 0-51.
+ * @param current Card on top of the played deck, 0-51.
+ * @return true if the suits or the ranks match.
+ */
+static inline bool packedMatches(PackedCard card, PackedCard current)
+{
+    return (cardMatchMasks[current] >> card) & 1u;
+}
+
 /**
  * @brief Prints a card in human-readable form (for example "Heart Queen").
  *
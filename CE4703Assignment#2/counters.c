@@ -0,0 +1,103 @@
+/**
+ * @file counters.c
+ * @brief Per-thread operation counters and their process totals
+ *
+ * @author Shrestha Dey
+ * @date 17 October 2026
+ */
+#include "counters.h"
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#if CARDGAME_COUNTERS
+
+COUNTER_THREAD_LOCAL OpCounters threadCounters;
+
+/// Counts flushed by threads, only ever added to atomically
+static volatile unsigned long long totalCounters[NUM_COUNTERS];
+
+/**
+ * @brief Helper function to add to a total shared by all threads
+ *
+ * @param total Total to add to
+ * @param value Amount to add
+ */
+static void atomicAdd(volatile unsigned long long* total, unsigned long long value)
+{
+#ifdef _WIN32
+    InterlockedExchangeAdd64((volatile LONG64*)total, (LONG64)value);
+#else
+    __atomic_fetch_add(total, value, __ATOMIC_RELAXED);
+#endif
+}
+
+#endif
+
+/**
+ * @brief Name of a counter
+ */
+const char* counterName(OpCounter counter)
+{
+    static const char* const names[NUM_COUNTERS] = {
+        "games", "compares", "sorts", "sorts_skipped", "shuffles", "shuffled_cards",
+        "reshuffles", "remove_at", "remove_steps", "inserts", "insert_steps",
+        "node_mallocs", "pool_nodes", "slab_mallocs", "array_mallocs", "block_mallocs"
+    };
+    return counter >= 0 && counter < NUM_COUNTERS ? names[counter] : "unknown";
+}
+
+/**
+ * @brief Copies the calling thread's counts
+ */
+void readThreadCounters(OpCounters* out)
+{
+#if CARDGAME_COUNTERS
+    *out = threadCounters;
+#else
+    memset(out, 0, sizeof(*out));
+#endif
+}
+
+/**
+ * @brief Adds the calling thread's counts to the process totals
+ */
+void flushThreadCounters(void)
+{
+#if CARDGAME_COUNTERS
+    for (int i = 0; i < NUM_COUNTERS; i++) {
+        if (threadCounters.values[i]) {
+            atomicAdd(&totalCounters[i], threadCounters.values[i]);
+        }
+    }
+    memset(&threadCounters, 0, sizeof(threadCounters));
+#endif
+}
+
+/**
+ * @brief Reads the process totals
+ */
+void readTotalCounters(OpCounters* out)
+{
+#if CARDGAME_COUNTERS
+    for (int i = 0; i < NUM_COUNTERS; i++) {
+        out->values[i] = totalCounters[i] + threadCounters.values[i];
+    }
+#else
+    memset(out, 0, sizeof(*out));
+#endif
+}
+
+/**
+ * @brief Prints every counter, in total and per game
+ */
+void printCounterReport(FILE* out, const OpCounters* counters, long long games)
+{
+    fprintf(out, "counter,total,per_game\n");
+    for (int i = 0; i < NUM_COUNTERS; i++) {
+        fprintf(out, "%s,%llu,%.3f\n", counterName((OpCounter)i), counters->values[i],
+            games > 0 ? (double)counters->values[i] / (double)games : 0.0);
+    }
+}
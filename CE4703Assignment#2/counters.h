@@ -0,0 +1,124 @@
+/**
+ * @file counters.h
+ * @brief Operation counters for the deck and game hot paths
+ *
+ * The counters only exist when the program is built with
+ * CARDGAME_COUNTERS=1 (the CMake option of the same name). Otherwise
+ * COUNT_OP() and COUNT_OPS() expand to nothing, so the normal build has
+ * no extra loads, stores or branches in deck.c and friends.
+ *
+ * Each thread counts into its own thread-local block, so workers never
+ * share a cache line. A worker thread adds its block to the process
+ * totals with flushThreadCounters() before it exits; the totals are
+ * read back with readTotalCounters() and printed by printCounterReport().
+ *
+ * @author Shrestha Dey
+ * @date 17 October 2026
+ */
+
+#pragma once
+#ifndef COUNTERS_H
+#define COUNTERS_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#ifndef CARDGAME_COUNTERS
+#define CARDGAME_COUNTERS 0
+#endif
+
+/**
+ * @brief What is counted
+ */
+typedef enum {
+    COUNTER_GAMES,          ///< games dealt
+    COUNTER_COMPARES,       ///< compareCards() calls
+    COUNTER_SORTS,          ///< sortDeck() calls that sorted
+    COUNTER_SORTS_SKIPPED,  ///< sortDeck() calls on an already sorted deck
+    COUNTER_SHUFFLES,       ///< shuffleDeck() calls
+    COUNTER_SHUFFLED_CARDS, ///< cards passed through shuffleDeck()
+    COUNTER_RESHUFFLES,     ///< played decks recycled by reshuffleHiddenDeck()
+    COUNTER_REMOVE_AT,      ///< removeCardAt() calls
+    COUNTER_REMOVE_STEPS,   ///< nodes walked (list) or cards moved (ring) by removeCardAt()
+    COUNTER_INSERTS,        ///< insertCardSorted() calls
+    COUNTER_INSERT_STEPS,   ///< nodes walked (list) or cards moved (ring) by insertCardSorted()
+    COUNTER_NODE_MALLOCS,   ///< list nodes taken from malloc() by decks without a pool
+    COUNTER_POOL_NODES,     ///< list nodes taken from a NodePool
+    COUNTER_SLAB_MALLOCS,   ///< slabs a NodePool took from malloc()
+    COUNTER_ARRAY_MALLOCS,  ///< card arrays a ring buffer deck without a pool took from malloc()
+    COUNTER_BLOCK_MALLOCS,  ///< game, deck and card array blocks a NodePool took from malloc()
+    NUM_COUNTERS
+} OpCounter;
+
+/**
+ * @brief One value per counter
+ */
+typedef struct {
+    unsigned long long values[NUM_COUNTERS];  ///< Counts, by OpCounter
+} OpCounters;
+
+#if CARDGAME_COUNTERS
+
+#ifdef _MSC_VER
+#define COUNTER_THREAD_LOCAL __declspec(thread)
+#else
+#define COUNTER_THREAD_LOCAL _Thread_local
+#endif
+
+/// Counts of the calling thread since it started or last flushed
+extern COUNTER_THREAD_LOCAL OpCounters threadCounters;
+
+#define COUNT_OP(counter) (threadCounters.values[counter]++)
+#define COUNT_OPS(counter, n) (threadCounters.values[counter] += (unsigned long long)(n))
+
+#else
+
+#define COUNT_OP(counter) ((void)0)
+#define COUNT_OPS(counter, n) ((void)0)
+
+#endif
+
+/**
+ * @brief Name of a counter, as printed in the report
+ *
+ * @param counter Counter
+ * @return Short snake_case name
+ */
+const char* counterName(OpCounter counter);
+
+/**
+ * @brief Copies the calling thread's counts
+ *
+ * Read before and after a game to get that game's counts.
+ *
+ * @param out Where to store the counts, all zero when counters are off
+ */
+void readThreadCounters(OpCounters* out);
+
+/**
+ * @brief Adds the calling thread's counts to the process totals and
+ * zeroes them
+ *
+ * Safe to call from several threads at once. Does nothing when the
+ * counters are off.
+ */
+void flushThreadCounters(void);
+
+/**
+ * @brief Reads the process totals, the calling thread's unflushed counts
+ * included
+ *
+ * @param out Where to store the counts, all zero when counters are off
+ */
+void readTotalCounters(OpCounters* out);
+
+/**
+ * @brief Prints every counter, in total and per game
+ *
+ * @param out Stream to print to
+ * @param counters Counts to print
+ * @param games Games the counts cover, for the per-game column
+ */
+void printCounterReport(FILE* out, const OpCounters* counters, long long games);
+
+#endif // !COUNTERS_H
@@ -4,28 +4,39 @@
  *
  * This file implements all the CardDeck functions declared in deck.h.
  * The deck uses a singly linked list with head and tail pointers.
+ * The ring buffer backend lives in deckRing.c; functions that only read
+ * the deck through DeckIterator are shared by both backends.
  *
  * @author Shrestha Dey
  * @date 25 November 2025
  */
+#include "counters.h"
 #include "deck.h"
+#include "nodePool.h"
+#include "profiler.h"
+#include "sort.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 
-#define CARDS_PER_PACK 52
+#if !DECK_RING_BUFFER
 
  /**
  * @brief Helper function to create a new node
  * 
  * Allocates memory for a new node and initializes it with the given card.
+ * The node comes from the deck's pool when it has one.
  *
+ * @param deck The deck the node is for
  * @param card The card to store in the node
  * @return Pointer to the new node, or NULL on allocation failure
  */
-static CardNode* createNode(Card card)
+static CardNode* createNode(CardDeck* deck, Card card)
 {
-    CardNode* node = malloc(sizeof(CardNode));
+    if (!deck->pool) {
+        COUNT_OP(COUNTER_NODE_MALLOCS);
+    }
+    CardNode* node = deck->pool ? poolAllocNode(deck->pool) : malloc(sizeof(CardNode));
     if (!node) {
         return NULL;
     }
@@ -34,18 +45,34 @@ static CardNode* createNode(Card card)
     return node;
 }
 
+/**
+ * @brief Helper function to release a node removed from a deck
+ *
+ * @param deck The deck the node was removed from
+ * @param node The node to release
+ */
+static void releaseNode(CardDeck* deck, CardNode* node)
+{
+    if (deck->pool) {
+        poolFreeNode(deck->pool, node);
+    }
+    else {
+        free(node);
+    }
+}
+
 
 /**
- * @brief Initializes a new deck with the specified number of card packs
+ * @brief Initializes a new deck whose nodes come from a NodePool
  */
-CardDeck* initDeck(int num_packs)
+CardDeck* initDeckWithPool(int num_packs, uint64_t seed, NodePool* pool)
 {
     if (num_packs < 0) {
         return NULL;
     }
 
     /// Allocate the deck structure
-    CardDeck* deck = malloc(sizeof(CardDeck));
+    CardDeck* deck = poolAllocBlock(pool, sizeof(CardDeck));
     if (!deck) {
         return NULL;
     }
@@ -53,6 +80,10 @@ CardDeck* initDeck(int num_packs)
     deck->head = NULL;
     deck->tail = NULL;
     deck->size = 0;
+    deck->sorted = true;
+    deck->unshuffled = 0;
+    deck->pool = pool;
+    seedRng(&deck->rng, seed);
 
     /// Fill the deck with complete packs
     for (int pack = 0; pack < num_packs; pack++) {
@@ -81,6 +112,12 @@ void freeDeck(CardDeck* deck)
     }
 
     /// Free all nodes in the linked list
+    if (deck->pool) {
+        poolFreeChain(deck->pool, deck->head, deck->tail);
+        poolFreeBlock(deck->pool, deck, sizeof(CardDeck));
+        return;
+    }
+
     CardNode* current = deck->head;
     while (current) {
         CardNode* next = current->next;
@@ -100,11 +137,16 @@ void shuffleDeck(CardDeck* deck)
     if (!deck || deck->size <= 1) {
         return;
     }
-
-    srand((unsigned int)time(NULL));
-    /// Convert linked list to array for shuffling
-    Card* temp_array = malloc(deck->size * sizeof(Card));
+    deck->unshuffled = 0;  /// a pending lazy shuffle is overtaken
+    PROFILE_BEGIN(PHASE_SHUFFLE);
+    COUNT_OP(COUNTER_SHUFFLES);
+    COUNT_OPS(COUNTER_SHUFFLED_CARDS, deck->size);
+
+    /// Convert linked list to array for shuffling (reuse the pool's buffer if any)
+    Card* temp_array = deck->pool ? poolScratch(deck->pool, deck->size)
+        : malloc(deck->size * sizeof(Card));
     if (!temp_array) {
+        PROFILE_END(PHASE_SHUFFLE);
         return;
     }
 
@@ -117,7 +159,7 @@ void shuffleDeck(CardDeck* deck)
 
     /// Fisher-Yates shuffle
     for (int i = deck->size - 1; i > 0; i--) {
-        int j = rand() % (i + 1);
+        int j = (int)randomBelow(&deck->rng, (uint32_t)i + 1);
         Card temp = temp_array[i];
         temp_array[i] = temp_array[j];
         temp_array[j] = temp;
@@ -130,8 +172,62 @@ void shuffleDeck(CardDeck* deck)
         current = current->next;
     }
 
-    free(temp_array);
+    if (!deck->pool) {
+        free(temp_array);
+    }
+    deck->sorted = false;
+    PROFILE_END(PHASE_SHUFFLE);
+}
+
+/**
+ * @brief Completes a shuffle started by shuffleDeckLazy()
+ *
+ * Copies the unshuffled cards to an array and runs the top-down
+ * Fisher-Yates steps that removeTopCard() takes one at a time with the
+ * ring buffer backend.
+ */
+void finishShuffle(CardDeck* deck)
+{
+    int count = deck->unshuffled;
+    deck->unshuffled = 0;
+    if (count <= 1) {
+        return;
+    }
+    PROFILE_BEGIN(PHASE_SHUFFLE);
+    COUNT_OPS(COUNTER_SHUFFLED_CARDS, count);
+
+    Card* temp_array = deck->pool ? poolScratch(deck->pool, count)
+        : malloc(count * sizeof(Card));
+    if (!temp_array) {
+        PROFILE_END(PHASE_SHUFFLE);
+        return;
+    }
+
+    CardNode* current = deck->head;
+    for (int i = 0; i < count; i++) {
+        temp_array[i] = current->card;
+        current = current->next;
+    }
+
+    for (int i = 0; i < count - 1; i++) {
+        int j = i + (int)randomBelow(&deck->rng, (uint32_t)(count - i));
+        Card temp = temp_array[i];
+        temp_array[i] = temp_array[j];
+        temp_array[j] = temp;
+    }
+
+    current = deck->head;
+    for (int i = 0; i < count; i++) {
+        current->card = temp_array[i];
+        current = current->next;
+    }
+
+    if (!deck->pool) {
+        free(temp_array);
+    }
+    PROFILE_END(PHASE_SHUFFLE);
 }
+
 /**
  *@brief Adds a card to the beginning of the deck
  */
@@ -140,12 +236,15 @@ bool addCard(CardDeck* deck, Card card)
     if (!deck) {
         return false;
     }
+    finishShuffle(deck);
 
-    CardNode* new_node = createNode(card);
+    CardNode* new_node = createNode(deck, card);
     if (!new_node) {
         return false;
     }
 
+    deck->sorted = deck->size == 0 || (deck->sorted && compareCards(&card, &deck->head->card) <= 0);
+
     /// Add to the beginning (head)
     new_node->next = deck->head;
     deck->head = new_node;
@@ -168,7 +267,7 @@ bool addCardToEnd(CardDeck* deck, Card card)
         return false;
     }
 
-    CardNode* new_node = createNode(card);
+    CardNode* new_node = createNode(deck, card);
     if (!new_node) {
         return false;
     }
@@ -177,8 +276,10 @@ bool addCardToEnd(CardDeck* deck, Card card)
         //empty deck
         deck->head = new_node;
         deck->tail = new_node;
+        deck->sorted = true;
     }
     else {
+        deck->sorted = deck->sorted && compareCards(&deck->tail->card, &card) <= 0;
         deck->tail->next = new_node;
         deck->tail = new_node;
     }
@@ -187,6 +288,51 @@ bool addCardToEnd(CardDeck* deck, Card card)
     deck->size++;
     return true;
 }
+
+/**
+ * @brief Inserts a card at its place in a sorted deck
+ *
+ * Cards in order with the bottom card are appended in O(1), the others
+ * are linked in after a walk from the top.
+ */
+bool insertCardSorted(CardDeck* deck, Card card)
+{
+    if (!deck) {
+        return false;
+    }
+    COUNT_OP(COUNTER_INSERTS);
+    if (!deck->sorted) {
+        sortDeck(deck);
+    }
+    if (!deck->tail || compareCards(&deck->tail->card, &card) <= 0) {
+        return addCardToEnd(deck, card);
+    }
+
+    CardNode* new_node = createNode(deck, card);
+    if (!new_node) {
+        return false;
+    }
+
+    /// Find the last node that does not come after the card (NULL: insert at the top)
+    CardNode* before = NULL;
+    CardNode* current = deck->head;
+    while (compareCards(&current->card, &card) <= 0) {
+        before = current;
+        current = current->next;
+        COUNT_OP(COUNTER_INSERT_STEPS);
+    }
+
+    new_node->next = current;
+    if (before) {
+        before->next = new_node;
+    }
+    else {
+        deck->head = new_node;
+    }
+
+    deck->size++;
+    return true;
+}
 /**
  * @brief Removes and returns the top card from the deck
  */
@@ -195,6 +341,7 @@ bool removeTopCard(CardDeck* deck, Card* out_card)
     if (!deck || !out_card || !deck->head) {
         return false;
     }
+    finishShuffle(deck);
 
     // Store the card from the head node
     *out_card = deck->head->card;
@@ -208,7 +355,7 @@ bool removeTopCard(CardDeck* deck, Card* out_card)
         deck->tail = NULL;
     }
 
-    free(old_head);
+    releaseNode(deck, old_head);
     deck->size--;
     return true;
 }
@@ -222,12 +369,16 @@ bool removeCardAt(CardDeck* deck, int position, Card* out_card)
         return false;
     }
 
+    COUNT_OP(COUNTER_REMOVE_AT);
+    finishShuffle(deck);
+
     /// Special case: removing from position 0 (head)
     if (position == 0) {
         return removeTopCard(deck, out_card);
     }
 
     /// Traverse to the node before the target position
+    COUNT_OPS(COUNTER_REMOVE_STEPS, position - 1);
     CardNode* current = deck->head;
     for (int i = 0; i < position - 1; i++) {
         current = current->next;
@@ -243,11 +394,254 @@ bool removeCardAt(CardDeck* deck, int position, Card* out_card)
         deck->tail = current;
     }
 
-    free(to_remove);
+    releaseNode(deck, to_remove);
     deck->size--;
     return true;
 }
 
+/**
+ * @brief Helper function to append copies of a run of nodes to a deck
+ *
+ * If a copy cannot be allocated, the copies made so far are released in
+ * one pass from the old bottom card, so dest is left as it was.
+ *
+ * @param first First node of the run
+ * @param count Number of nodes in the run
+ * @param dest The deck to append to
+ * @return true on success, false on memory allocation failure
+ */
+static bool copyRun(const CardNode* first, int count, CardDeck* dest)
+{
+    CardNode* old_tail = dest->tail;
+    bool old_sorted = dest->sorted;
+    for (int i = 0; i < count; i++, first = first->next) {
+        if (!addCardToEnd(dest, first->card)) {
+            CardNode* node = old_tail ? old_tail->next : dest->head;
+            while (node) {
+                CardNode* next = node->next;
+                releaseNode(dest, node);
+                node = next;
+            }
+            if (old_tail) {
+                old_tail->next = NULL;
+            }
+            else {
+                dest->head = NULL;
+            }
+            dest->tail = old_tail;
+            dest->size -= i;
+            dest->sorted = old_sorted;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Moves a run of cards from one deck onto the bottom of another
+ */
+bool spliceCards(CardDeck* src, int position, int count, CardDeck* dest)
+{
+    if (!src || !dest || src == dest || position < 0 || count < 0
+        || position > src->size - count) {
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+
+    finishShuffle(src);
+
+    /// Find the node before the run (NULL if the run starts at the top)
+    CardNode* before = NULL;
+    CardNode* first = src->head;
+    for (int i = 0; i < position; i++) {
+        before = first;
+        first = first->next;
+    }
+
+    /// Find the last node of the run, src->tail if it reaches the bottom
+    CardNode* last;
+    if (position + count == src->size) {
+        last = src->tail;
+    }
+    else {
+        last = first;
+        for (int i = 1; i < count; i++) {
+            last = last->next;
+        }
+    }
+
+    /// Nodes from different allocators cannot be relinked, copy them
+    bool copy = src->pool != dest->pool;
+    if (copy && !copyRun(first, count, dest)) {
+        return false;
+    }
+
+    /// Unlink the run from src
+    CardNode* after = last->next;
+    if (before) {
+        before->next = after;
+    }
+    else {
+        src->head = after;
+    }
+    if (!after) {
+        src->tail = before;
+    }
+    src->size -= count;
+
+    /// The copies are in dest already, give the run's nodes back in one pass
+    if (copy) {
+        while (count-- > 0) {
+            CardNode* next = first->next;
+            releaseNode(src, first);
+            first = next;
+        }
+        return true;
+    }
+
+    /// Link it onto the bottom of dest, a run of a sorted deck is sorted
+    dest->sorted = src->sorted
+        && (!dest->tail || (dest->sorted && compareCards(&dest->tail->card, &first->card) <= 0));
+    last->next = NULL;
+    if (dest->tail) {
+        dest->tail->next = first;
+    }
+    else {
+        dest->head = first;
+    }
+    dest->tail = last;
+    dest->size += count;
+    return true;
+}
+
+/**
+ * @brief Returns the card at a position without removing it
+ */
+const Card* peekCardAt(const CardDeck* deck, int position)
+{
+    if (!deck || position < 0 || position >= deck->size) {
+        return NULL;
+    }
+
+    CardNode* current = deck->head;
+    for (int i = 0; i < position; i++) {
+        current = current->next;
+    }
+    return &current->card;
+}
+
+/**
+ * @brief Linked lists have no contiguous storage
+ */
+Card* linearizeDeck(CardDeck* deck)
+{
+    (void)deck;
+    return NULL;
+}
+
+#endif /* !DECK_RING_BUFFER */
+
+/**
+ * @brief Initializes a new deck with the specified number of card packs
+ *
+ * The seed mixes the clock with the deck's address so that decks created
+ * within the same second still get different streams.
+ */
+CardDeck* initDeck(int num_packs)
+{
+    CardDeck* deck = initDeckSeeded(num_packs, 0);
+    if (deck) {
+        seedDeck(deck, (uint64_t)time(NULL) ^ ((uint64_t)clock() << 32)
+            ^ (uint64_t)(uintptr_t)deck);
+    }
+    return deck;
+}
+
+/**
+ * @brief Initializes a new deck whose shuffles are reproducible
+ */
+CardDeck* initDeckSeeded(int num_packs, uint64_t seed)
+{
+    return initDeckWithPool(num_packs, seed, NULL);
+}
+
+/**
+ * @brief Reseeds the random stream used to shuffle a deck
+ */
+void seedDeck(CardDeck* deck, uint64_t seed)
+{
+    seedRng(&deck->rng, seed);
+}
+
+/**
+ * @brief Shuffles the deck as its cards are drawn
+ */
+void shuffleDeckLazy(CardDeck* deck)
+{
+    if (!deck || deck->size <= 1) {
+        return;
+    }
+    COUNT_OP(COUNTER_SHUFFLES);
+    deck->unshuffled = deck->size;
+    deck->sorted = false;
+}
+
+/**
+ * @brief Splits a deck at a position
+ */
+bool splitDeck(CardDeck* deck, int position, CardDeck* dest)
+{
+    if (!deck || position < 0 || position > deck->size) {
+        return false;
+    }
+    return spliceCards(deck, position, deck->size - position, dest);
+}
+
+/**
+ * @brief Moves all but the top keep cards onto the bottom of another deck
+ */
+int moveAllButTop(CardDeck* src, int keep, CardDeck* dest)
+{
+    if (!src || keep < 0) {
+        return -1;
+    }
+    if (keep >= src->size) {
+        return 0;
+    }
+
+    int count = src->size - keep;
+    return spliceCards(src, keep, count, dest) ? count : -1;
+}
+
+/**
+ * @brief Copies the deck's cards into a packed array
+ */
+int packDeck(const CardDeck* deck, PackedCard* out)
+{
+    DeckIterator it = deckBegin(deck);
+    const Card* card;
+    int count = 0;
+    while ((card = deckNext(&it)) != NULL) {
+        out[count++] = packCard(*card);
+    }
+    return count;
+}
+
+/**
+ * @brief Adds packed cards to the bottom of the deck
+ */
+bool addPackedCards(CardDeck* deck, const PackedCard* cards, int count)
+{
+    for (int i = 0; i < count; i++) {
+        if (!addCardToEnd(deck, unpackCard(cards[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /**
  * @brief Checks if the deck is empty
  */
@@ -267,12 +661,12 @@ void printDeck(const CardDeck* deck)
     }
 
     printf("Deck has %d cards:\n", deck->size);
-    CardNode* current = deck->head;
+    DeckIterator it = deckBegin(deck);
+    const Card* card;
     int index = 0;
-    while (current) {
+    while ((card = deckNext(&it)) != NULL) {
         printf("%d: ", index++);
-        printCard(&current->card);
+        printCard(card);
         printf("\n");
-        current = current->next;
     }
-}
\ No newline at end of file
+}
@@ -7,6 +7,11 @@
  * memory allocation to support any number of cards. It provides operations 
  * for shuffling, adding/removing cards, and more.
  *
+ * Two storage backends are available and selected at compile time with
+ * DECK_RING_BUFFER: the original singly linked list (default) and a
+ * contiguous ring buffer with O(1) push/pop at both ends. Both backends
+ * expose exactly the same API, so they can be benchmarked against each other.
+ *
  * @author Shrestha Dey
  * @date 25 November 2025
  */
@@ -16,7 +21,25 @@
 #define DECK_H
 
 #include "card.h"
+#include "rng.h"
 #include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Selects the CardDeck storage backend
+ *
+ * 0 = singly linked list of CardNodes (default),
+ * 1 = contiguous ring buffer of Cards (deckRing.c).
+ * Define it on the compiler command line, e.g. /DDECK_RING_BUFFER=1.
+ */
+#ifndef DECK_RING_BUFFER
+#define DECK_RING_BUFFER 0
+#endif
+
+#define CARDS_PER_PACK 52
+
+/** @brief Slab allocator for CardNodes, see nodePool.h */
+typedef struct NodePool NodePool;
 
  /**
   * @brief Node structure for the linked list
@@ -26,6 +49,23 @@ typedef struct CardNode {
     struct CardNode* next;  ///< Pointer to the next node, or NULL if this is the last node
 } CardNode;
 
+#if DECK_RING_BUFFER
+/**
+* @brief  Structure representing a deck of playing cards (ring buffer backend)
+*
+* Card at position i (0 = top) is stored at cards[(head + i) & (capacity - 1)].
+*/
+typedef struct {
+    Card* cards;     ///< Ring storage, capacity is always a power of two
+    int capacity;    ///< Number of slots allocated in cards
+    int head;        ///< Slot index of the top card
+    int size;        ///< Current number of cards in the deck
+    bool sorted;     ///< Cards are known to be in compareCards() order, see insertCardSorted()
+    int unshuffled;  ///< Cards on top still to be shuffled in, see shuffleDeckLazy()
+    Rng rng;         ///< Random stream used by shuffleDeck()
+    NodePool* pool;  ///< Keeps the deck and its storage when freed, or NULL to use malloc/free
+} CardDeck;
+#else
 /**
 * @brief  Structure representing a deck of playing cards
 */
@@ -33,7 +73,27 @@ typedef struct {
     CardNode* head;  ///< Pointer to the first node in the list (top of deck)
     CardNode* tail;  ///< Pointer to the last node in the list (bottom of deck)
     int size;        ///< Current number of cards in the deck
+    bool sorted;     ///< Cards are known to be in compareCards() order, see insertCardSorted()
+    int unshuffled;  ///< Cards on top still to be shuffled in, see shuffleDeckLazy()
+    Rng rng;         ///< Random stream used by shuffleDeck()
+    NodePool* pool;  ///< Allocator for the nodes, or NULL to use malloc/free
 } CardDeck;
+#endif
+
+/**
+ * @brief Read-only cursor for walking a deck from top to bottom
+ *
+ * Use deckBegin() to start and deckNext() to advance; this hides the
+ * storage backend from code that only needs to look at the cards.
+ */
+typedef struct {
+#if DECK_RING_BUFFER
+    const CardDeck* deck;   ///< Deck being walked
+    int index;              ///< Position of the next card to return
+#else
+    const CardNode* node;   ///< Node holding the next card to return
+#endif
+} DeckIterator;
 
 /**
  * @brief Initializes a new deck with the specified number of card packs
@@ -41,16 +101,56 @@ typedef struct {
  * Creates a deck containing num_packs complete packs of 52 cards each.
  * Each pack contains all 4 suits with cards from Two to Ace.
  * The deck is allocated dynamically and must be freed with freeDeck().
+ * Its random stream is seeded from the clock; use initDeckSeeded() for
+ * reproducible shuffles.
  *
  * @param num_packs Number of complete card packs to include (>= 0)
  * @return Pointer to newly created CardDeck or NULL on failure
  */
 CardDeck* initDeck(int num_packs);
 
+/**
+ * @brief Initializes a new deck whose shuffles are reproducible
+ *
+ * Same as initDeck(), but the deck's random stream starts from seed, so
+ * the same seed always gives the same sequence of shuffles.
+ *
+ * @param num_packs Number of complete card packs to include (>= 0)
+ * @param seed Seed for the deck's random stream
+ * @return Pointer to newly created CardDeck or NULL on failure
+ */
+CardDeck* initDeckSeeded(int num_packs, uint64_t seed);
+
+/**
+ * @brief Initializes a new deck whose nodes come from a NodePool
+ *
+ * Same as initDeckSeeded(), but every node the deck ever needs is taken
+ * from pool and given back to it by removals and freeDeck(). Decks that
+ * exchange cards should share one pool. The deck structure itself, and
+ * the card storage of the ring buffer backend, are taken from the pool's
+ * spare blocks too (poolAllocBlock()).
+ *
+ * @param num_packs Number of complete card packs to include (>= 0)
+ * @param seed Seed for the deck's random stream
+ * @param pool Node allocator, or NULL to use malloc/free
+ * @return Pointer to newly created CardDeck or NULL on failure
+ */
+CardDeck* initDeckWithPool(int num_packs, uint64_t seed, NodePool* pool);
+
+/**
+ * @brief Reseeds the random stream used to shuffle a deck
+ *
+ * @param deck Pointer to the deck, cannot be NULL
+ * @param seed New seed for the deck's random stream
+ */
+void seedDeck(CardDeck* deck, uint64_t seed);
+
 /**
  * @brief Frees all memory associated with a deck
  *
  * Deallocates all nodes in the linked list and the deck structure itself.
+ * Nodes taken from a NodePool are given back to the pool in one step,
+ * and the pool keeps the deck structure for the next deck.
  * After calling this, the deck pointer becomes invalid.
  *
  * @param deck Pointer to the deck to be freed, can be NULL
@@ -62,11 +162,47 @@ void freeDeck(CardDeck* deck);
  *
  * Uses the Fisher-Yates shuffle algorithm to randomize the order
  * of all cards in the deck.
+ * Random numbers come from the deck's own stream (see initDeckSeeded()),
+ * so decks can be shuffled from several threads at once.
  *
  * @param deck Pointer to the deck to shuffle, cannot be NULL
  */
 void shuffleDeck(CardDeck* deck);
 
+/**
+ * @brief Shuffles the deck as its cards are drawn
+ *
+ * Only marks the deck as shuffled. Each removeTopCard() then takes one
+ * step of a top-down Fisher-Yates shuffle: it swaps a uniformly random
+ * card that has not been drawn yet to the top and removes it. Every
+ * order of draws is exactly as likely as after shuffleDeck(), but with
+ * the ring buffer backend only the cards that are drawn cost anything.
+ * The linked list cannot reach a random card in O(1), so it finishes the
+ * whole shuffle at its first draw.
+ *
+ * Cards added to the bottom stay below the shuffled ones. Any other
+ * change to the deck first finishes the shuffle with finishShuffle(),
+ * which takes the same random steps the draws would have, so when the
+ * shuffle is finished never changes which cards come out. The read-only
+ * functions (peekCardAt(), packDeck(), printDeck() and DeckIterator) see
+ * the cards in their order before the shuffle until it is finished.
+ *
+ * The random numbers are used differently from shuffleDeck(), so the
+ * same seed gives another order.
+ *
+ * @param deck Pointer to the deck to shuffle, cannot be NULL
+ */
+void shuffleDeckLazy(CardDeck* deck);
+
+/**
+ * @brief Completes a shuffle started by shuffleDeckLazy()
+ *
+ * Does nothing if the deck has no shuffle pending.
+ *
+ * @param deck Pointer to the deck, cannot be NULL
+ */
+void finishShuffle(CardDeck* deck);
+
 /**
  * @brief Adds a card to the top of the deck
  *
@@ -87,11 +223,28 @@ bool addCard(CardDeck* deck, Card card);
 */
 bool addCardToEnd(CardDeck* deck, Card card);
 
+/**
+ * @brief Inserts a card at its place in a sorted deck
+ *
+ * Every deck keeps a sorted flag that is true while its cards are known
+ * to be in compareCards() order: adding a card keeps it when the card is
+ * in order with its new neighbour, removing cards never clears it, and a
+ * shuffle does. If the flag is set the card goes straight after the last
+ * card that does not compare greater; otherwise the deck is first sorted
+ * with sortDeck(). A drawn card thus costs one insert instead of a sort.
+ *
+ * @param deck Pointer to the deck, cannot be NULL
+ * @param card Card to insert
+ * @return true if the card was inserted, false on memory allocation failure
+ */
+bool insertCardSorted(CardDeck* deck, Card card);
+
 /**
  * @brief Removes and returns the top card from the deck
  *
  * The top card is the head of linked list (first card).
  * The head pointer is updated to point to the next card.
+ * With a shuffle pending it is a random card, see shuffleDeckLazy().
  *
  * @param deck Pointer to the deck, cannot be NULL
  * @param out_card Pointer to store the removed card, cannot be NULL
@@ -111,6 +264,69 @@ bool removeTopCard(CardDeck* deck, Card* out_card);
  */
 bool removeCardAt(CardDeck* deck, int position, Card* out_card);
 
+/**
+ * @brief Moves a run of cards from one deck onto the bottom of another
+ *
+ * The count cards starting at position leave src and are appended to the
+ * bottom of dest in the same order. With the linked list backend this is
+ * a relink: O(position) to find the run, plus O(count) only when the run
+ * stops short of the bottom of src. With the ring buffer the cards are
+ * copied in one pass. Linked list decks should share the same NodePool;
+ * otherwise the run is copied into new nodes, still in O(position + count).
+ *
+ * @param src Deck to take the cards from, cannot be NULL
+ * @param position Position of the first card to move (0 is the top)
+ * @param count Number of cards to move (>= 0)
+ * @param dest Deck receiving the cards, cannot be NULL or src
+ * @return true if the cards were moved, false if the range is invalid or
+ *         memory ran out (src and dest are then unchanged)
+ */
+bool spliceCards(CardDeck* src, int position, int count, CardDeck* dest);
+
+/**
+ * @brief Splits a deck at a position
+ *
+ * Cards from position to the bottom move onto the bottom of dest, the
+ * cards above position stay in deck.
+ *
+ * @param deck Deck to split, cannot be NULL
+ * @param position First card that moves (0 to size)
+ * @param dest Deck receiving the bottom part, cannot be NULL or deck
+ * @return true on success, false if position is invalid or memory ran out
+ */
+bool splitDeck(CardDeck* deck, int position, CardDeck* dest);
+
+/**
+ * @brief Moves all but the top keep cards onto the bottom of another deck
+ *
+ * With the linked list backend this costs O(keep) whatever the deck size.
+ *
+ * @param src Deck to take the cards from, cannot be NULL
+ * @param keep Number of cards that stay on top of src (>= 0)
+ * @param dest Deck receiving the cards, cannot be NULL or src
+ * @return Number of cards moved, or -1 on memory failure
+ */
+int moveAllButTop(CardDeck* src, int keep, CardDeck* dest);
+
+/**
+ * @brief Copies the deck's cards into a packed array, top card first
+ *
+ * @param deck Deck to read, cannot be NULL
+ * @param out Array of at least deck->size packed cards
+ * @return Number of cards written
+ */
+int packDeck(const CardDeck* deck, PackedCard* out);
+
+/**
+ * @brief Adds packed cards to the bottom of the deck, in array order
+ *
+ * @param deck Deck to add to, cannot be NULL
+ * @param cards Packed cards, each 0-51
+ * @param count Number of cards
+ * @return true on success, false on memory allocation failure
+ */
+bool addPackedCards(CardDeck* deck, const PackedCard* cards, int count);
+
 /**
  * @brief Checks if the deck is empty
  *
@@ -128,4 +344,70 @@ bool isEmpty(const CardDeck* deck);
  */
 void printDeck(const CardDeck* deck);
 
+/**
+ * @brief Returns the card at a position without removing it
+ *
+ * O(1) with the ring buffer backend, O(position) with the linked list.
+ *
+ * @param deck Pointer to the deck, cannot be NULL
+ * @param position Index of the card (0 to size-1)
+ * @return Pointer to the card inside the deck, or NULL if position is invalid
+ */
+const Card* peekCardAt(const CardDeck* deck, int position);
+
+/**
+ * @brief Makes the deck's cards contiguous in memory
+ *
+ * With the ring buffer backend the storage is rotated in place if the
+ * cards wrap around the end of the buffer, and a pointer to size consecutive
+ * cards is returned. The linked list has no contiguous storage, so NULL is
+ * returned.
+ *
+ * @param deck Pointer to the deck, cannot be NULL
+ * @return Pointer to the first (top) card, or NULL if not available
+ */
+Card* linearizeDeck(CardDeck* deck);
+
+/**
+ * @brief Starts an iteration over the deck from the top card
+ *
+ * @param deck Pointer to the deck, cannot be NULL
+ * @return Iterator positioned before the top card
+ */
+static inline DeckIterator deckBegin(const CardDeck* deck)
+{
+    DeckIterator it;
+#if DECK_RING_BUFFER
+    it.deck = deck;
+    it.index = 0;
+#else
+    it.node = deck->head;
+#endif
+    return it;
+}
+
+/**
+ * @brief Returns the next card of an iteration and advances the iterator
+ *
+ * @param it Iterator created by deckBegin()
+ * @return Pointer to the next card, or NULL once the bottom has been passed
+ */
+static inline const Card* deckNext(DeckIterator* it)
+{
+#if DECK_RING_BUFFER
+    const CardDeck* deck = it->deck;
+    if (it->index >= deck->size) {
+        return NULL;
+    }
+    return &deck->cards[(deck->head + it->index++) & (deck->capacity - 1)];
+#else
+    const CardNode* node = it->node;
+    if (!node) {
+        return NULL;
+    }
+    it->node = node->next;
+    return &node->card;
+#endif
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,432 @@
+/**
+ * @file deckRing.c
+ * @brief Ring buffer implementation of CardDeck operations
+ *
+ * This file implements the CardDeck functions declared in deck.h when
+ * DECK_RING_BUFFER is set. Cards are stored by value in one contiguous
+ * power-of-two sized array used as a circular buffer, so adding or
+ * removing at either end is O(1) and shuffling needs no temporary copy.
+ *
+ * @author Shrestha Dey
+ * @date 17 October 2026
+ */
+#include "counters.h"
+#include "deck.h"
+#include "nodePool.h"
+#include "profiler.h"
+#include "sort.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if DECK_RING_BUFFER
+
+#define MIN_CAPACITY 16
+
+/**
+ * @brief Helper function to map a deck position to a storage slot
+ *
+ * @param deck The deck
+ * @param position Position in the deck (0 is the top)
+ * @return Index into deck->cards
+ */
+static int slotOf(const CardDeck* deck, int position)
+{
+    return (deck->head + position) & (deck->capacity - 1);
+}
+
+/**
+ * @brief Helper function to reverse a range of slots in place
+ *
+ * @param cards Storage array
+ * @param from First slot of the range
+ * @param to One past the last slot of the range
+ */
+static void reverseSlots(Card* cards, int from, int to)
+{
+    while (from < --to) {
+        Card temp = cards[from];
+        cards[from++] = cards[to];
+        cards[to] = temp;
+    }
+}
+
+/**
+ * @brief Helper function to make room for at least needed cards
+ *
+ * Grows the storage to the next power of two and copies the cards over
+ * so that the top card ends up in slot 0.
+ *
+ * @param deck The deck to grow
+ * @param needed Number of cards the deck must be able to hold
+ * @return true on success, false on memory allocation failure
+ */
+static bool reserveCards(CardDeck* deck, int needed)
+{
+    if (needed <= deck->capacity) {
+        return true;
+    }
+
+    int capacity = deck->capacity ? deck->capacity : MIN_CAPACITY;
+    while (capacity < needed) {
+        if (capacity > INT_MAX / 2) {
+            return false;
+        }
+        capacity *= 2;
+    }
+
+    Card* cards;
+    if (deck->pool) {
+        cards = poolAllocBlock(deck->pool, (size_t)capacity * sizeof(Card));
+    } else {
+        COUNT_OP(COUNTER_ARRAY_MALLOCS);
+        cards = malloc((size_t)capacity * sizeof(Card));
+    }
+    if (!cards) {
+        return false;
+    }
+
+    /// Copy in deck order, unwrapping the ring
+    for (int i = 0; i < deck->size; i++) {
+        cards[i] = deck->cards[slotOf(deck, i)];
+    }
+
+    poolFreeBlock(deck->pool, deck->cards, (size_t)deck->capacity * sizeof(Card));
+    deck->cards = cards;
+    deck->capacity = capacity;
+    deck->head = 0;
+    return true;
+}
+
+/**
+ * @brief Initializes a new deck, its structure and storage come from the
+ * pool's spare blocks
+ */
+CardDeck* initDeckWithPool(int num_packs, uint64_t seed, NodePool* pool)
+{
+    if (num_packs < 0 || num_packs > INT_MAX / CARDS_PER_PACK) {
+        return NULL;
+    }
+
+    /// Allocate the deck structure
+    CardDeck* deck = poolAllocBlock(pool, sizeof(CardDeck));
+    if (!deck) {
+        return NULL;
+    }
+
+    deck->pool = pool;
+    deck->cards = NULL;
+    deck->capacity = 0;
+    deck->head = 0;
+    deck->size = 0;
+    deck->sorted = num_packs <= 1;  /// one pack is built in order
+    deck->unshuffled = 0;
+    seedRng(&deck->rng, seed);
+
+    if (!reserveCards(deck, num_packs * CARDS_PER_PACK)) {
+        freeDeck(deck);
+        return NULL;
+    }
+
+    /// Fill the deck with complete packs, storage is already large enough
+    for (int pack = 0; pack < num_packs; pack++) {
+        for (Suit s = CLUB; s <= DIAMOND; s++) {
+            for (Rank r = TWO; r <= ACE; r++) {
+                Card c = { s, r };
+                deck->cards[deck->size++] = c;
+            }
+        }
+    }
+
+    return deck;
+}
+
+/**
+ * @brief Frees all memory associated with a deck
+ */
+void freeDeck(CardDeck* deck)
+{
+    if (!deck) {
+        return;
+    }
+
+    poolFreeBlock(deck->pool, deck->cards, (size_t)deck->capacity * sizeof(Card));
+    poolFreeBlock(deck->pool, deck, sizeof(CardDeck));
+}
+
+/**
+ * @brief Shuffles the deck randomly
+ */
+void shuffleDeck(CardDeck* deck)
+{
+    if (!deck || deck->size <= 1) {
+        return;
+    }
+
+    PROFILE_BEGIN(PHASE_SHUFFLE);
+    COUNT_OP(COUNTER_SHUFFLES);
+    COUNT_OPS(COUNTER_SHUFFLED_CARDS, deck->size);
+    deck->unshuffled = 0;  /// a pending lazy shuffle is overtaken
+    Card* cards = linearizeDeck(deck);
+
+    /// Fisher-Yates shuffle, directly on the contiguous storage
+    for (int i = deck->size - 1; i > 0; i--) {
+        int j = (int)randomBelow(&deck->rng, (uint32_t)i + 1);
+        Card temp = cards[i];
+        cards[i] = cards[j];
+        cards[j] = temp;
+    }
+    deck->sorted = false;
+    PROFILE_END(PHASE_SHUFFLE);
+}
+
+/**
+ * @brief Completes a shuffle started by shuffleDeckLazy()
+ *
+ * Runs the remaining top-down Fisher-Yates steps in place, the same ones
+ * removeTopCard() would have taken one per draw.
+ */
+void finishShuffle(CardDeck* deck)
+{
+    int count = deck->unshuffled;
+    deck->unshuffled = 0;
+    if (count <= 1) {
+        return;
+    }
+    PROFILE_BEGIN(PHASE_SHUFFLE);
+    COUNT_OPS(COUNTER_SHUFFLED_CARDS, count);
+
+    for (int i = 0; i < count - 1; i++) {
+        int j = i + (int)randomBelow(&deck->rng, (uint32_t)(count - i));
+        Card temp = deck->cards[slotOf(deck, i)];
+        deck->cards[slotOf(deck, i)] = deck->cards[slotOf(deck, j)];
+        deck->cards[slotOf(deck, j)] = temp;
+    }
+    PROFILE_END(PHASE_SHUFFLE);
+}
+
+/**
+ * @brief Adds a card to the top of the deck
+ */
+bool addCard(CardDeck* deck, Card card)
+{
+    if (!deck || !reserveCards(deck, deck->size + 1)) {
+        return false;
+    }
+    finishShuffle(deck);
+
+    deck->sorted = deck->size == 0 || (deck->sorted && compareCards(&card, &deck->cards[deck->head]) <= 0);
+    deck->head = (deck->head - 1) & (deck->capacity - 1);
+    deck->cards[deck->head] = card;
+    deck->size++;
+    return true;
+}
+
+/**
+ * @brief Adds a card to the bottom of the deck
+ */
+bool addCardToEnd(CardDeck* deck, Card card)
+{
+    if (!deck || !reserveCards(deck, deck->size + 1)) {
+        return false;
+    }
+
+    deck->sorted = deck->size == 0
+        || (deck->sorted && compareCards(&deck->cards[slotOf(deck, deck->size - 1)], &card) <= 0);
+    deck->cards[slotOf(deck, deck->size)] = card;
+    deck->size++;
+    return true;
+}
+
+/**
+ * @brief Inserts a card at its place in a sorted deck
+ *
+ * The position is found by binary search, then the cards on the shorter
+ * side of it move by one slot.
+ */
+bool insertCardSorted(CardDeck* deck, Card card)
+{
+    if (!deck || !reserveCards(deck, deck->size + 1)) {
+        return false;
+    }
+    COUNT_OP(COUNTER_INSERTS);
+    if (!deck->sorted) {
+        sortDeck(deck);
+    }
+
+    /// First position whose card comes after the new one
+    int low = 0;
+    int high = deck->size;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (compareCards(&deck->cards[slotOf(deck, mid)], &card) <= 0) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+
+    COUNT_OPS(COUNTER_INSERT_STEPS, low < deck->size / 2 ? low : deck->size - low);
+    if (low < deck->size / 2) {
+        /// Open the gap from the top side
+        deck->head = (deck->head - 1) & (deck->capacity - 1);
+        for (int i = 0; i < low; i++) {
+            deck->cards[slotOf(deck, i)] = deck->cards[slotOf(deck, i + 1)];
+        }
+    }
+    else {
+        /// Open the gap from the bottom side
+        for (int i = deck->size; i > low; i--) {
+            deck->cards[slotOf(deck, i)] = deck->cards[slotOf(deck, i - 1)];
+        }
+    }
+
+    deck->cards[slotOf(deck, low)] = card;
+    deck->size++;
+    return true;
+}
+
+/**
+ * @brief Removes and returns the top card from the deck
+ */
+bool removeTopCard(CardDeck* deck, Card* out_card)
+{
+    if (!deck || !out_card || deck->size == 0) {
+        return false;
+    }
+
+    /// One step of a pending lazy shuffle: a random unshuffled card comes to the top
+    if (deck->unshuffled > 0) {
+        if (deck->unshuffled > 1) {
+            int j = slotOf(deck, (int)randomBelow(&deck->rng, (uint32_t)deck->unshuffled));
+            Card temp = deck->cards[deck->head];
+            deck->cards[deck->head] = deck->cards[j];
+            deck->cards[j] = temp;
+        }
+        COUNT_OP(COUNTER_SHUFFLED_CARDS);
+        deck->unshuffled--;
+    }
+
+    *out_card = deck->cards[deck->head];
+    deck->head = (deck->head + 1) & (deck->capacity - 1);
+    deck->size--;
+    return true;
+}
+
+/**
+ * @brief Removes a card at a specific position in the deck
+ *
+ * Only the cards on the shorter side of the position are moved.
+ */
+bool removeCardAt(CardDeck* deck, int position, Card* out_card)
+{
+    if (!deck || !out_card || position < 0 || position >= deck->size) {
+        return false;
+    }
+
+    finishShuffle(deck);
+    *out_card = deck->cards[slotOf(deck, position)];
+    COUNT_OP(COUNTER_REMOVE_AT);
+    COUNT_OPS(COUNTER_REMOVE_STEPS, position < deck->size / 2 ? position : deck->size - 1 - position);
+
+    if (position < deck->size / 2) {
+        /// Close the gap from the top side
+        for (int i = position; i > 0; i--) {
+            deck->cards[slotOf(deck, i)] = deck->cards[slotOf(deck, i - 1)];
+        }
+        deck->head = (deck->head + 1) & (deck->capacity - 1);
+    }
+    else {
+        /// Close the gap from the bottom side
+        for (int i = position; i < deck->size - 1; i++) {
+            deck->cards[slotOf(deck, i)] = deck->cards[slotOf(deck, i + 1)];
+        }
+    }
+
+    deck->size--;
+    return true;
+}
+
+/**
+ * @brief Moves a run of cards from one deck onto the bottom of another
+ *
+ * The run is copied into dest, then the gap in src is closed by moving
+ * whichever side of the run is shorter (nothing at all for a run at the
+ * top or at the bottom).
+ */
+bool spliceCards(CardDeck* src, int position, int count, CardDeck* dest)
+{
+    if (!src || !dest || src == dest || position < 0 || count < 0
+        || position > src->size - count) {
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+    if (!reserveCards(dest, dest->size + count)) {
+        return false;
+    }
+    finishShuffle(src);
+
+    /// Append the run to dest, a run of a sorted deck is sorted
+    dest->sorted = src->sorted && (dest->size == 0
+        || (dest->sorted && compareCards(&dest->cards[slotOf(dest, dest->size - 1)], &src->cards[slotOf(src, position)]) <= 0));
+    for (int i = 0; i < count; i++) {
+        dest->cards[slotOf(dest, dest->size + i)] = src->cards[slotOf(src, position + i)];
+    }
+    dest->size += count;
+
+    /// Close the gap in src
+    int above = position;
+    int below = src->size - position - count;
+    if (above < below) {
+        for (int i = above - 1; i >= 0; i--) {
+            src->cards[slotOf(src, i + count)] = src->cards[slotOf(src, i)];
+        }
+        src->head = slotOf(src, count);
+    }
+    else {
+        for (int i = 0; i < below; i++) {
+            src->cards[slotOf(src, position + i)] = src->cards[slotOf(src, position + count + i)];
+        }
+    }
+    src->size -= count;
+    return true;
+}
+
+/**
+ * @brief Returns the card at a position without removing it
+ */
+const Card* peekCardAt(const CardDeck* deck, int position)
+{
+    if (!deck || position < 0 || position >= deck->size) {
+        return NULL;
+    }
+    return &deck->cards[slotOf(deck, position)];
+}
+
+/**
+ * @brief Makes the deck's cards contiguous in memory
+ *
+ * If the cards wrap around the end of the storage, the whole buffer is
+ * rotated in place (three reversals) so the top card moves to slot 0.
+ */
+Card* linearizeDeck(CardDeck* deck)
+{
+    if (!deck || deck->size == 0) {
+        return deck ? deck->cards : NULL;
+    }
+    finishShuffle(deck);
+
+    if (deck->head + deck->size > deck->capacity) {
+        reverseSlots(deck->cards, 0, deck->head);
+        reverseSlots(deck->cards, deck->head, deck->capacity);
+        reverseSlots(deck->cards, 0, deck->capacity);
+        deck->head = 0;
+    }
+
+    return &deck->cards[deck->head];
+}
+
+#endif /* DECK_RING_BUFFER */
@@ -0,0 +1,267 @@
+/**
+ * @file eventSink.c
+ * @brief Buffered text output for game events
+ *
+ * The text sink reproduces the play-by-play the game used to printf
+ * directly, but collects it in a 64 KiB buffer that is written to the
+ * stream in large blocks.
+ *
+ * @author Oluwatunmise Adegbola
+ * @date 17 October 2026
+*/
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "eventSink.h"
+#include "game.h"
+
+#define TEXT_BUFFER_SIZE 65536
+
+
+/**
+ * @brief Buffered writer behind a text sink
+ */
+typedef struct TextOutput {
+	FILE* out;	// stream the buffer is written to
+	size_t used;	// bytes waiting in buffer
+	char buffer[TEXT_BUFFER_SIZE];	// pending output
+} TextOutput;
+
+
+/**
+ * @brief Writes the buffered bytes to the stream
+ *
+ * @param text Writer to flush
+ */
+static void flushText(TextOutput* text)
+{
+	if (text -> used > 0) {
+		fwrite(text -> buffer, 1, text -> used, text -> out);
+		text -> used = 0;
+	}
+}
+
+
+/**
+ * @brief printf into the buffer, flushing first if the text does not fit
+ *
+ * @param text Writer
+ * @param format printf format
+ */
+static void writeText(TextOutput* text, const char* format, ...)
+{
+	va_list args;
+	size_t space = TEXT_BUFFER_SIZE - text -> used;
+
+	va_start(args, format);
+	int length = vsnprintf(text -> buffer + text -> used, space, format, args);
+	va_end(args);
+
+	if (length < 0) {
+		return;
+	}
+	if ((size_t)length < space) {
+		text -> used += (size_t)length;
+		return;
+	}
+
+	// did not fit: flush and format again, straight to the stream if still too long
+	flushText(text);
+	va_start(args, format);
+	if ((size_t)length < TEXT_BUFFER_SIZE) {
+		text -> used = (size_t)vsnprintf(text -> buffer, TEXT_BUFFER_SIZE, format, args);
+	} else {
+		vfprintf(text -> out, format, args);
+	}
+	va_end(args);
+}
+
+
+/**
+ * @brief Writes a card as "Suit Rank" and a newline, like printCard()
+ *
+ * @param text Writer
+ * @param card Card to write
+ */
+static void writeCard(TextOutput* text, const Card* card)
+{
+	writeText(text, "%s %s\n", suitToString(card -> suit), rankToString(card -> rank));
+}
+
+
+/**
+ * @brief Writes a player's hand, one numbered card per line
+ *
+ * @param text Writer
+ * @param playerIndex Index of the player
+ * @param hand Player's hand
+ */
+static void writeHand(TextOutput* text, int playerIndex, const CardDeck* hand)
+{
+	writeText(text, "Player %d hand (%d cards): \n", playerIndex + 1, hand -> size);
+	DeckIterator it = deckBegin(hand);
+	const Card* card;
+	int index = 0;
+	while ((card = deckNext(&it)) != NULL) {
+		writeText(text, " [%d] ", index++);
+		writeCard(text, card);
+	}
+	writeText(text, "\n");
+}
+
+
+/**
+ * @brief Turns one event into text
+ *
+ * @param sink Text sink
+ * @param event Event to write
+ */
+static void handleTextEvent(EventSink* sink, const GameEvent* event)
+{
+	TextOutput* text = sink -> context;
+	const GameState* game = event -> game;
+	const char* name = (game && event -> player >= 0) ? game -> players[event -> player].name : "";
+
+	switch (event -> type) {
+	case EVENT_GAME_START:
+		writeText(text, "=== Game Start! ===\n");
+		writeText(text, "Using %d pack(s) of cards.\n", event -> value);
+		break;
+	case EVENT_INIT_FAILED:
+		writeText(text, "game did not initialise :(\n");
+		break;
+	case EVENT_GAME_BEGIN:
+		writeText(text, "\n=== Let the games begin! ===\n");
+		writeText(text, "\nInitial card on table: ");
+		writeCard(text, &event -> card);
+		writeText(text, "\n\n");
+		break;
+	case EVENT_HAND:
+		writeHand(text, event -> player, game -> players[event -> player].hand);
+		break;
+	case EVENT_TURN_START:
+		writeText(text, "It's %s's turn!\n", name);
+		break;
+	case EVENT_STATE:
+		writeText(text, "\n=== GAME STATE ===\n");
+		writeText(text, "Current card: ");
+		writeCard(text, &game -> currentCard);
+		writeText(text, "\n");
+		writeText(text, "Current player: %s\n", game -> players[game -> currentPlayer].name);
+		writeText(text, "Hidden deck: %d cards\n", hiddenDeckSize(game));
+		writeText(text, "Played deck: %d cards\n", game -> playedDeck -> size);
+		writeText(text, "\n");
+		break;
+	case EVENT_PLAY:
+		writeText(text, "%s plays a card from their hand!\n", name);
+		writeText(text, " %s played : ", name);
+		writeCard(text, &event -> card);
+		writeText(text, "\n");
+		break;
+	case EVENT_NO_MATCH:
+		writeText(text, "%s has no matching card and must draw!\n", name);
+		break;
+	case EVENT_DRAW:
+		writeText(text, "%s draws:", name);
+		writeCard(text, &event -> card);
+		writeText(text, "\n");
+		break;
+	case EVENT_RESHUFFLE_START:
+		writeText(text, "Hidden deck empty! Please hol up while it reshuffles. \n");
+		break;
+	case EVENT_RESHUFFLE:
+		writeText(text, "Reshuffled! hidden deck now has %d cards! \n", event -> value);
+		break;
+	case EVENT_TURN_END:
+		writeText(text, "\n");
+		break;
+	case EVENT_WIN:
+		writeText(text, "\n*** %s wins the game! ***\n", name);
+		writeText(text, "Game Over! %s wins!\n", name);
+		break;
+	case EVENT_NO_WINNER:
+		writeText(text, "\n*** Nobody wins the game (%s) ***\n", outcomeToString((GameOutcome)event -> value));
+		break;
+	case EVENT_GAME_END:
+		writeText(text, "=== Game Over! ===\n");
+		break;
+	}
+}
+
+
+/**
+ * @brief Creates a sink that writes the play-by-play as text
+ *
+ * @param out Stream to write to
+ * @param level Verbosity of the output
+ * @return New sink, or NULL on allocation failure
+ */
+EventSink* createTextSink(FILE* out, Verbosity level)
+{
+	EventSink* sink = malloc(sizeof(EventSink));
+	TextOutput* text = malloc(sizeof(TextOutput));
+	if (!sink || !text) {
+		free(sink);
+		free(text);
+		return NULL;
+	}
+
+	text -> out = out;
+	text -> used = 0;
+	sink -> level = level;
+	sink -> handler = handleTextEvent;
+	sink -> context = text;
+	return sink;
+}
+
+
+/**
+ * @brief Writes out anything a text sink still has buffered
+ *
+ * @param sink Text sink, may be NULL
+ */
+void flushSink(EventSink* sink)
+{
+	if (sink) {
+		flushText(sink -> context);
+		fflush(((TextOutput*)sink -> context) -> out);
+	}
+}
+
+
+/**
+ * @brief Flushes and frees a text sink
+ *
+ * @param sink Text sink, may be NULL
+ */
+void freeSink(EventSink* sink)
+{
+	if (sink) {
+		flushSink(sink);
+		free(sink -> context);
+		free(sink);
+	}
+}
+
+
+/**
+ * @brief Parses a verbosity name or number
+ *
+ * @param text Text to parse
+ * @param level Where to store the level
+ * @return 1 on success, 0 otherwise
+ */
+int parseVerbosity(const char* text, Verbosity* level)
+{
+	static const char* const names[] = { "silent", "summary", "turns", "full" };
+
+	for (int i = 0; i <= VERBOSITY_FULL; i++) {
+		if (strcmp(text, names[i]) == 0 || (text[0] == '0' + i && text[1] == '\0')) {
+			*level = (Verbosity)i;
+			return 1;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,188 @@
+/**
+ * @file eventSink.h
+ * @brief Game events, verbosity levels and the buffered text output
+ *
+ * Game logic does not print. It reports what happens as GameEvents to an
+ * EventSink, which decides what to do with them. Every event has a
+ * verbosity level, and emitEvent() checks it before anything is built,
+ * so a game without a sink (or with a silent one) pays one compare per
+ * event and nothing else.
+ *
+ * The text sink turns events into the familiar play-by-play, written
+ * through a large buffer instead of one printf per line.
+ *
+ * @author Oluwatunmise Adegbola
+ * @date 17 October 2026
+*/
+
+#ifndef EVENTSINK_H
+#define EVENTSINK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "card.h"
+
+struct GameState;
+
+/**
+  * @brief How much of a game gets reported
+*/
+typedef enum Verbosity {
+	VERBOSITY_SILENT = 0,	// nothing
+	VERBOSITY_SUMMARY,	// start, winner and end of each game
+	VERBOSITY_TURNS,	// plus every play, draw and reshuffle
+	VERBOSITY_FULL	// plus game state and hand dumps every turn
+} Verbosity;
+
+/**
+  * @brief Kinds of game events
+*/
+typedef enum EventType {
+	EVENT_GAME_START,	// value = number of packs
+	EVENT_INIT_FAILED,	// the game could not be created
+	EVENT_GAME_BEGIN,	// cards dealt, card = first card on the table
+	EVENT_HAND,	// dump of player's hand
+	EVENT_TURN_START,	// player's turn begins
+	EVENT_STATE,	// dump of the game state
+	EVENT_PLAY,	// player played card
+	EVENT_NO_MATCH,	// player has nothing to play and must draw
+	EVENT_DRAW,	// player drew card
+	EVENT_RESHUFFLE_START,	// hidden deck is empty
+	EVENT_RESHUFFLE,	// played deck recycled, value = hidden deck size
+	EVENT_TURN_END,	// player's turn is over
+	EVENT_WIN,	// player has no cards left
+	EVENT_NO_WINNER,	// game stopped without a winner, value = GameOutcome
+	EVENT_GAME_END	// game finished and freed
+} EventType;
+
+/**
+  * @brief One thing that happened in a game
+*/
+typedef struct GameEvent {
+	EventType type;	// what happened
+	const struct GameState* game;	// game it happened in, NULL once freed
+	int player;	// player involved, -1 if none
+	Card card;	// card involved, if any
+	int value;	// extra number, see EventType
+} GameEvent;
+
+typedef struct EventSink EventSink;
+
+/**
+  * @brief Callback receiving the events a sink lets through
+*/
+typedef void (*EventHandler)(EventSink* sink, const GameEvent* event);
+
+/**
+  * @brief Receiver of game events
+*/
+struct EventSink {
+	Verbosity level;	// events above this level are never built
+	EventHandler handler;	// called for every event at or below level
+	void* context;	// handler's own data
+};
+
+/**
+  * @brief Returns the verbosity level an event type belongs to.
+  *
+  * @param type Event type
+  * @return Lowest verbosity at which the event is reported
+*/
+static inline Verbosity eventLevel(EventType type)
+{
+	switch (type) {
+	case EVENT_GAME_START:
+	case EVENT_INIT_FAILED:
+	case EVENT_WIN:
+	case EVENT_NO_WINNER:
+	case EVENT_GAME_END:
+		return VERBOSITY_SUMMARY;
+	case EVENT_HAND:
+	case EVENT_STATE:
+		return VERBOSITY_FULL;
+	default:
+		return VERBOSITY_TURNS;
+	}
+}
+
+/**
+  * @brief Checks whether a sink wants events of a given type.
+  *
+  * @param sink Sink, may be NULL (silent)
+  * @param type Event type
+  * @return true if the event would be handled
+*/
+static inline bool sinkWants(const EventSink* sink, EventType type)
+{
+	return sink != NULL && sink -> level >= eventLevel(type);
+}
+
+/**
+  * @brief Reports an event to a sink if its level lets it through.
+  *
+  * @param sink Sink, may be NULL (silent)
+  * @param game Game the event happened in, may be NULL
+  * @param type Event type
+  * @param player Player involved, -1 if none
+  * @param card Card involved, may be NULL
+  * @param value Extra number, see EventType
+*/
+static inline void emitEvent(EventSink* sink, const struct GameState* game, EventType type,
+	int player, const Card* card, int value)
+{
+	if (!sinkWants(sink, type)) {
+		return;
+	}
+
+	GameEvent event;
+	event.type = type;
+	event.game = game;
+	event.player = player;
+	if (card) {
+		event.card = *card;
+	} else {
+		event.card.suit = CLUB;
+		event.card.rank = TWO;
+	}
+	event.value = value;
+	sink -> handler(sink, &event);
+}
+
+/**
+  * @brief Creates a sink that writes the play-by-play as text.
+  *
+  * Output is collected in a buffer and written out when it fills up, on
+  * flushSink() and on freeSink().
+  *
+  * @param out Stream to write to, cannot be NULL
+  * @param level Verbosity of the output
+  * @return New sink, or NULL on allocation failure
+*/
+EventSink* createTextSink(FILE* out, Verbosity level);
+
+/**
+  * @brief Writes out anything a text sink still has buffered.
+  *
+  * @param sink Sink created by createTextSink(), may be NULL
+*/
+void flushSink(EventSink* sink);
+
+/**
+  * @brief Flushes and frees a text sink.
+  *
+  * @param sink Sink created by createTextSink(), may be NULL
+*/
+void freeSink(EventSink* sink);
+
+/**
+  * @brief Parses a verbosity name (silent, summary, turns, full) or number.
+  *
+  * @param text Text to parse
+  * @param level Where to store the level
+  * @return 1 on success, 0 if the text is not a verbosity level
+*/
+int parseVerbosity(const char* text, Verbosity* level);
+
+#endif // !EVENTSINK_H
@@ -12,57 +12,202 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
+#include "counters.h"
 #include "game.h"
+#include "gameRecord.h"
+#include "nodePool.h"
+#include "profiler.h"
+#include "zobrist.h"
+
+/**
+ * @brief Helper function to shuffle the hidden deck
+ *
+ * A lazy shuffle only marks the deck, each draw then takes a random card,
+ * so the cards that are never drawn cost nothing.
+ *
+ * @param game Game state
+*/
+static void shuffleHiddenDeck(GameState* game)
+{
+	if (game -> lazyShuffle) {
+		shuffleDeckLazy(game -> hiddenDeck);
+	} else {
+		shuffleDeck(game -> hiddenDeck);
+	}
+}
+
 
 /* --- game init and cleanup --- */
 GameState* initGame(int numPacks)
 {
-	if (numPacks <= 0) {
+	return initGameSeeded(numPacks, (uint64_t)time(NULL) ^ ((uint64_t)clock() << 32));
+}
+
+
+/**
+ * @brief Creates a game whose shuffles are fully determined by a seed
+ *
+ * The seed drives the hidden deck's random stream, which is used for the
+ * initial shuffle and for every reshuffle, so the same seed always
+ * replays the same game. No global state is touched, which makes it safe
+ * to run independent games on several threads.
+ *
+ * @param numPacks Number of card packs to use
+ * @param seed Seed for the hidden deck's random stream
+ * @return New game state, or NULL on failure
+*/
+GameState* initGameSeeded(int numPacks, uint64_t seed)
+{
+	GameConfig config;
+	initGameConfig(&config, numPacks, seed);
+	return initGameWithConfig(&config);
+}
+
+
+/**
+ * @brief Fills a game configuration with the default settings
+ *
+ * @param config Configuration to fill
+ * @param numPacks Number of card packs to use
+ * @param seed Seed for the hidden deck's random stream
+*/
+void initGameConfig(GameConfig* config, int numPacks, uint64_t seed)
+{
+	config -> numPacks = numPacks;
+	config -> numPlayers = NUM_PLAYERS;
+	config -> seed = seed;
+	config -> sink = NULL;
+	config -> pool = NULL;
+	config -> record = NULL;
+	for (int i = 0; i < MAX_PLAYERS; i++) {
+		config -> strategies[i] = NULL;
+	}
+	config -> maxTurns = DEFAULT_MAX_TURNS;
+	config -> maxRepeats = DEFAULT_MAX_REPEATS;
+	config -> lazyHiddenDeck = 0;
+	config -> lazyShuffle = 0;
+}
+
+
+/**
+ * @brief Helper function to build a game, see initGameWithConfig()
+ *
+ * @param config Game settings
+ * @return New game state, or NULL on failure
+*/
+static GameState* buildGame(const GameConfig* config)
+{
+	if (config -> numPacks <= 0 || config -> numPlayers < MIN_PLAYERS || config -> numPlayers > MAX_PLAYERS
+		|| (long long)config -> numPacks * CARDS_PER_PACK < (long long)config -> numPlayers * INITIAL_HAND_SIZE + 1
+		|| config -> maxTurns < 0 || config -> maxRepeats < 0 || config -> maxRepeats == 1) {
 		return NULL;
 	}
 
-	GameState* game = malloc(sizeof(GameState));
+	// a pool from the configuration keeps the blocks of earlier games, so
+	// a warm one hands them out again instead of the heap
+	GameState* game = poolAllocBlock(config -> pool, sizeof(GameState));
 	if (!game) {
 		return NULL;
 	}
+	memset(game, 0, sizeof(GameState));
+
+	// players are sized for this table
+	game -> players = poolAllocBlock(config -> pool, (size_t)config -> numPlayers * sizeof(Player));
+	if (!game -> players) {
+		poolFreeBlock(config -> pool, game, sizeof(GameState));
+		return NULL;
+	}
+	memset(game -> players, 0, (size_t)config -> numPlayers * sizeof(Player));
+	game -> numPlayers = config -> numPlayers;
+
+	// node pool shared by every deck of the game
+	game -> pool = config -> pool;
+	if (!game -> pool) {
+		game -> pool = createNodePool(0);
+		game -> ownsPool = 1;
+		if (!game -> pool) {
+			poolFreeBlock(NULL, game -> players, (size_t)config -> numPlayers * sizeof(Player));
+			poolFreeBlock(NULL, game, sizeof(GameState));
+			return NULL;
+		}
+	}
 
-	// init hidden deck
-	game -> hiddenDeck = initDeck(numPacks);
+	// init hidden deck, a lazy one is only card counts so it costs the same for any number of packs
+	game -> lazyHiddenDeck = config -> lazyHiddenDeck;
+	game -> hiddenDeck = initDeckWithPool(game -> lazyHiddenDeck ? 0 : config -> numPacks, config -> seed, game -> pool);
 	if (!game -> hiddenDeck) {
-		free(game);
+		freeGame(game);
 		return NULL;
 	}
-	shuffleDeck(game -> hiddenDeck);
+	game -> lazyShuffle = config -> lazyShuffle;
+	if (game -> lazyHiddenDeck) {
+		initVirtualDeck(&game -> virtualHidden, config -> numPacks, config -> seed);
+	} else {
+		shuffleHiddenDeck(game);
+	}
 
 	// init palyed deck 
-	game -> playedDeck = initDeck(0);	// empty deck
+	game -> playedDeck = initDeckWithPool(0, config -> seed, game -> pool);	// empty deck
 	if (!game -> playedDeck) {
-		freeDeck(game -> hiddenDeck);
-		free(game);
+		freeGame(game);
 		return NULL;
 	}
 
 	// init players
-	for (int i = 0; i < NUM_PLAYERS; i++) {
-		game -> players[i].hand = initDeck(0);	// empty hand
+	for (int i = 0; i < game -> numPlayers; i++) {
+		game -> players[i].hand = initDeckWithPool(0, config -> seed, game -> pool);	// empty hand
 		if (!game -> players[i].hand) {
 			//if fail, then clean.
-			for (int j = 0; j < i; j++) {
-				freeDeck(game -> players[j].hand);
-			}
-			freeDeck(game -> hiddenDeck);
-			freeDeck(game -> playedDeck);
-			free(game);
-
+			freeGame(game);
 			return NULL;
 		}
-		sprintf(game -> players[i].name, sizeof(game -> players[i].name), "Player %d", i + 1);
+		initHandIndex(&game -> players[i].index);
+		snprintf(game -> players[i].name, sizeof(game -> players[i].name), "Player %d", i + 1);
 	}
 
 	game -> currentPlayer = 0;
 	game -> gameOver = 0;
+	game -> sink = config -> sink;
+	game -> turns = 0;
+	game -> draws = 0;
+	game -> reshuffles = 0;
+	game -> outcome = OUTCOME_NONE;
+	game -> maxTurns = config -> maxTurns;
+	game -> maxRepeats = config -> maxRepeats;
+
+	// strategies draw from their own stream so the deck's stays untouched
+	for (int i = 0; i < game -> numPlayers; i++) {
+		game -> strategies[i] = config -> strategies[i];
+	}
+	seedRng(&game -> strategyRng, ~config -> seed);
 
+	game -> record = config -> record;
+	if (game -> record) {
+		startGameRecord(game -> record, config -> numPacks, config -> numPlayers, config -> seed);
+	}
+
+	return game;
+}
+
+
+/**
+ * @brief Creates a game from a configuration
+ *
+ * All decks of the game take their nodes from one NodePool: the one in
+ * the configuration if given (so a thread can reuse it across games),
+ * otherwise a pool owned by the game. The deck must hold enough cards
+ * to deal every player a full hand and turn up a first card.
+ *
+ * @param config Game settings
+ * @return New game state, or NULL on failure
+*/
+GameState* initGameWithConfig(const GameConfig* config)
+{
+	PROFILE_BEGIN(PHASE_INIT_GAME);
+	GameState* game = buildGame(config);
+	PROFILE_END(PHASE_INIT_GAME);
 	return game;
 }
 
@@ -70,6 +215,8 @@ GameState* initGame(int numPacks)
 /**
  * @brief Frees all memory associated with the game
  *
+ * Works on a partly created game too, missing decks are skipped.
+ *
  * @param game Game state to free
 */
 
@@ -80,22 +227,66 @@ void freeGame(GameState* game)
 		return;
 	}
 
-	for (int i = 0; i < NUM_PLAYERS; i++) {
+	NodePool* pool = game -> pool;
+	for (int i = 0; i < game -> numPlayers; i++) {
 		freeDeck(game -> players[i].hand);
 	}
+	poolFreeBlock(pool, game -> players, (size_t)game -> numPlayers * sizeof(Player));
 
 	freeDeck(game -> hiddenDeck);
 	freeDeck(game -> playedDeck);
-	free(game);
+
+	// decks give their nodes back to the pool, so it goes last; a game that
+	// owns its pool was not taken from it either
+	if (game -> ownsPool) {
+		freeNodePool(pool);
+		pool = NULL;
+	}
+	poolFreeBlock(pool, game, sizeof(GameState));
 }
 
 /* --- game op ---*/
 
 
+/**
+ * @brief Number of cards left in the hidden deck
+ *
+ * Use this instead of hiddenDeck -> size, which is always 0 in a game
+ * with a lazy hidden deck.
+ *
+ * @param game Game state
+ * @return Cards that can still be drawn before a reshuffle
+*/
+int hiddenDeckSize(const GameState* game)
+{
+	return game -> lazyHiddenDeck ? game -> virtualHidden.size : game -> hiddenDeck -> size;
+}
+
+
+/**
+ * @brief Helper function to take the next card of the hidden deck
+ *
+ * The top card of a shuffled hidden deck, or a random card of a lazy one.
+ *
+ * @param game Game state
+ * @param card Where to store the card
+ * @return 1 if a card was drawn, 0 if the hidden deck is empty
+*/
+static int drawHiddenCard(GameState* game, Card* card)
+{
+	if (game -> lazyHiddenDeck) {
+		return drawVirtualCard(&game -> virtualHidden, card);
+	}
+	return removeTopCard(game -> hiddenDeck, card);
+}
+
+
 /**
  * @brief Deals initial cards to all players
  *
  * Deals INITIAL_HAND_SIZE cards to each player alternately from the hidden deck.
+ * The record gets the cards in deal order, then every hand is sorted, which
+ * is the order findMatchingCard() positions refer to.
  *
  * @param game Game state
 */
@@ -103,28 +294,44 @@ void freeGame(GameState* game)
 /* -- give initial cards to players -- */
 void dealInitialCards(GameState* game)
 {
+	PROFILE_BEGIN(PHASE_DEAL);
+	COUNT_OP(COUNTER_GAMES);
+
 	for (int i = 0; i < INITIAL_HAND_SIZE; i++) {
-		for (int p = 0; p < NUM_PLAYERS; p++) {
-			if (!isEmpty(game -> hiddenDeck)) {
-				Card drawnCard;
-				if (removeTopCard(game -> hiddenDeck, &drawnCard)) {
-					addCardToEnd(game -> players[p].hand, drawnCard);
-				}
+		for (int p = 0; p < game -> numPlayers; p++) {
+			Card drawnCard;
+			if (drawHiddenCard(game, &drawnCard)) {
+				addCardToEnd(game -> players[p].hand, drawnCard);
+				handIndexAdd(&game -> players[p].index, drawnCard);
 			}
 		}
 	}
 
 	// draw initial card for the played deck 
-	if (!isEmpty(game -> hiddenDeck)) {
-		removeTopCard(game -> hiddenDeck, &game -> currentCard);
+	if (drawHiddenCard(game, &game -> currentCard)) {
 		addCard(game -> playedDeck, game -> currentCard);
 	}
+	rehashGame(game);
+
+	if (game -> record) {
+		recordDeal(game -> record, game);
+	}
+
+	for (int p = 0; p < game -> numPlayers; p++) {
+		sortDeck(game -> players[p].hand);
+	}
+	PROFILE_END(PHASE_DEAL);
 }
 
 
 /**
  * @brief Finds the first matching card in player's hand
  *
+ * Uses the player's HandIndex instead of walking the hand, so the cost
+ * does not grow with the hand size. The index is the card's position in
+ * the sorted hand; dealInitialCards() sorts every hand and draws insert
+ * in order, so hands are always sorted.
+ *
  * @param game Game state
  * @param playerIndex Index of player to check
  * @return Index of matching card, or -1 if no match found
@@ -133,19 +340,15 @@ void dealInitialCards(GameState* game)
 /* -- find the first matching card -- */
 int findMatchingCard(const GameState* game, int playerIndex)
 {
+	PROFILE_BEGIN(PHASE_FIND_MATCH);
 	const Player* player = &game -> players[playerIndex];
-	CardNode* current = player -> hand -> head;
-	int index = 0;
 
-	while (current != NULL) {
-		if (isValidMove(&current -> card, &game -> currentCard)) {
-			return index;
-		}
-		current = current -> next;
-		index++;
+	int match = -1;	// no matching card found 🥀
+	if (handHasMatch(&player -> index, &game -> currentCard)) {
+		match = handFirstMatch(&player -> index, &game -> currentCard, NULL);
 	}
-
-	return -1;	// no matching card found 🥀
+	PROFILE_END(PHASE_FIND_MATCH);
+	return match;
 }
 
 
@@ -153,6 +356,8 @@ int findMatchingCard(const GameState* game, int playerIndex)
  * @brief Checks if a card can be played on the current card
  *
  * A card is valid if it matches the current card's suit OR rank.
+ * Cards with a suit or rank out of range are accepted and compared
+ * field by field.
  *
  * @param card Card to check
  * @param currentCard Current top card
@@ -162,7 +367,11 @@ int findMatchingCard(const GameState* game, int playerIndex)
 /* -- checks if a card can be played indeed -- */
 int isValidMove(const Card* card, const Card* currentCard)
 {
-	return (card -> suit == currentCard -> suit) || (card -> rank == currentCard -> rank);
+	// the match table only covers the 52 real cards, anything else is compared field by field
+	if (!isValidCard(*card) || !isValidCard(*currentCard)) {
+		return card -> suit == currentCard -> suit || card -> rank == currentCard -> rank;
+	}
+	return packedMatches(packCard(*card), packCard(*currentCard));
 }
 
 
@@ -189,14 +398,19 @@ int playCard(GameState* game, int playerIndex, int cardIndex)
 	if (!removeCardAt(player -> hand, cardIndex, &playedCard)) {
 		return 0;
 	}
+	handIndexRemove(&player -> index, playedCard);
+	zobristRemoveCard(game, ZOBRIST_HAND(playerIndex), playedCard);
 
 	// update currentcard and add to played deck
+	game -> hash += zobristCurrentKey(playedCard) - zobristCurrentKey(game -> currentCard);
 	game -> currentCard = playedCard;
 	addCard(game -> playedDeck, playedCard);
+	zobristAddCard(game, ZOBRIST_PLAYED, playedCard);
 
-	printf(" %s played : ", player -> name);
-	printCard(&playedCard);
-	printf("\n");
+	if (game -> record) {
+		recordMove(game -> record, packCard(playedCard));
+	}
+	emitEvent(game -> sink, game, EVENT_PLAY, playerIndex, &playedCard, 0);
 
 	return 1;
 }
@@ -206,6 +420,9 @@ int playCard(GameState* game, int playerIndex, int cardIndex)
  * @brief Draws a card from hidden deck for player
  *
  * If hidden deck is empty, reshuffles played deck into hidden deck first.
+ * The card goes into its sorted place in the hand, so the hand never
+ * needs a full sort after a draw. If it cannot be stored there the game
+ * ends with OUTCOME_ERROR.
  *
  * @param game Game state
  * @param playerIndex Index of player drawing the card
@@ -214,23 +431,51 @@ int playCard(GameState* game, int playerIndex, int cardIndex)
 /* -- draw a card for a player -- */
 void drawCardForPlayer(GameState* game, int playerIndex)
 {
+	PROFILE_BEGIN(PHASE_DRAW);
 	Player* player = &game -> players[playerIndex];
 
 	// if hidden deck is empty, then reshuffle the game
-	if (isEmpty(game -> hiddenDeck)) {
+	if (hiddenDeckSize(game) == 0) {
 		reshuffleHiddenDeck(game);
 	}
 
 	// now actually draw a card from hidden deck for the player
-	if (!isEmpty(game -> hiddenDeck)) {
-		Card drawnCard;
-		if (removeTopCard(game -> hiddenDeck, &drawnCard)) {
-			addCardToEnd(player -> hand, drawnCard);
-			printf("%s draws:", player -> name);
-			printCard(&drawnCard);
-			printf("\n");
+	Card drawnCard;
+	if (drawHiddenCard(game, &drawnCard)) {
+		// hand stays sorted, no full sort needed
+		if (!insertCardSorted(player -> hand, drawnCard)) {
+			// the card is lost, so the game cannot go on under the rules
+			game -> outcome = OUTCOME_ERROR;
+			PROFILE_END(PHASE_DRAW);
+			return;
+		}
+		handIndexAdd(&player -> index, drawnCard);
+		zobristRemoveCard(game, ZOBRIST_HIDDEN, drawnCard);
+		zobristAddCard(game, ZOBRIST_HAND(playerIndex), drawnCard);
+		game -> draws++;
+		if (game -> record) {
+			recordMove(game -> record, MOVE_DRAW | packCard(drawnCard));
 		}
+		emitEvent(game -> sink, game, EVENT_DRAW, playerIndex, &drawnCard, 0);
+		PROFILE_END(PHASE_DRAW);
+		return;
+	}
+
+	// nothing left to draw, the turn passes
+	if (game -> record) {
+		recordMove(game -> record, MOVE_PASS);
 	}
+
+	// the played deck is down to the current card, so if no hand holds a
+	// match for it either, no turn can ever change anything again
+	for (int p = 0; p < game -> numPlayers; p++) {
+		if (handHasMatch(&game -> players[p].index, &game -> currentCard)) {
+			PROFILE_END(PHASE_DRAW);
+			return;
+		}
+	}
+	game -> outcome = OUTCOME_STALEMATE;
+	PROFILE_END(PHASE_DRAW);
 }
 
 
@@ -238,112 +483,130 @@ void drawCardForPlayer(GameState* game, int playerIndex)
  * @brief Reshuffles played deck into hidden deck
  *
  * Keeps the last played card in the played deck, moves the rest to hidden deck.
+ * The move is a single O(1) splice followed by one shuffle.
 */
 
 /* -- reshuffle played deck -- */
 void reshuffleHiddenDeck(GameState* game)
 {
-	printf("Hidden deck empty! Please hol up while it reshuffles. \n");
+	PROFILE_BEGIN(PHASE_RESHUFFLE);
+	emitEvent(game -> sink, game, EVENT_RESHUFFLE_START, -1, NULL, 0);
 
 	// keep the current card in played deck
 	if (game -> playedDeck -> size <= 1) {
+		PROFILE_END(PHASE_RESHUFFLE);
 		return; // the cards aret enough to reshuffle
 	}
 
-	// move all but the top card from played to hidden
-	while (game -> playedDeck -> size > 1) {
-		Card card;
-
-		//remove cards from the bottom so you dont reverse their order
-		removeCardAt(game -> playedDeck, game -> playedDeck -> size - 1, &card);
-		addCardToEnd(game -> hiddenDeck, card);
+	// move all but the top card from played to hidden in one splice,
+	// both decks share the game's node pool so this is just a relink;
+	// a lazy hidden deck draws at random, so its cards are just counted
+	if (game -> lazyHiddenDeck) {
+		moveIntoVirtualDeck(game -> playedDeck, 1, &game -> virtualHidden);
+	} else {
+		moveAllButTop(game -> playedDeck, 1, game -> hiddenDeck);
+		shuffleHiddenDeck(game);
 	}
-
-	shuffleDeck(game -> hiddenDeck);
-	printf("Reshuffled! hidden deck now has %d cards! \n", game -> hiddenDeck -> size);
+	COUNT_OP(COUNTER_RESHUFFLES);
+
+	// the moved cards are the played deck's cards but the top one, so
+	// their hash moves from one pile to the other in one step
+	uint64_t moved = game -> pileSums[ZOBRIST_PLAYED] - zobristCardKey(game -> currentCard);
+	game -> pileSums[ZOBRIST_HIDDEN] += moved;
+	game -> pileSums[ZOBRIST_PLAYED] -= moved;
+	game -> hash += (zobristPileKey(ZOBRIST_HIDDEN) - zobristPileKey(ZOBRIST_PLAYED)) * moved;
+	game -> reshuffles++;
+
+	// a game that keeps reshuffling back into the same position is going round in circles
+	if (game -> maxRepeats > 0
+		&& recordPosition(game -> reshuffleHashes, game -> reshuffles - 1, game -> hash) >= game -> maxRepeats) {
+		game -> outcome = OUTCOME_CYCLE;
+	}
+	emitEvent(game -> sink, game, EVENT_RESHUFFLE, -1, NULL, hiddenDeckSize(game));
+	PROFILE_END(PHASE_RESHUFFLE);
 }
 
-/* --- display fns ---*/
+/* --- game flow ---*/
 
 
 /**
- * @brief Prints a player's hand
+ * @brief Advances to next player's turn
  *
- * @param playerIndex Index of the player
- * @param hand Pointer to player's hand deck
+ * @param game Game state
 */
 
-/* -- print players hand -- */
-void printPlayerHand(int playerIndex, const CardDeck* hand)
+/* -- goes to player's next turn -- */
+void nextTurn(GameState* game)
 {
-	printf("Player %d hand (%d cards): \n", playerIndex + 1, hand -> size);
-	CardNode* current = hand -> head;
-	int index = 0;
-	while (current != NULL) {
-		printf(" [%d] ", index++);
-		printCard(&current -> card);
-		current = current -> next;
-
+	game -> hash -= zobristPlayerKey(game -> currentPlayer);
+	if (++game -> currentPlayer == game -> numPlayers) {
+		game -> currentPlayer = 0;
 	}
-	printf("\n");
+	game -> hash += zobristPlayerKey(game -> currentPlayer);
 }
 
 
 /**
- * @brief Prints current game state
+ * @file deck.c
+ * @brief Implementation of CardDeck operations
  *
- * @param game Game state
+ * This file implements all the CardDeck functions declared in deck.h.
+ * The deck uses a singly linked list with head and tail pointers.
+ *
+ * @author Shrestha Dey
+ * @date 25 November 2025
 */
 
-/* -- prints current game state -- */
-void printGameState(const GameState* game)
+/* -- check if game is over -- */
+int checkGameOver(const GameState* game)
 {
-	printf("\n=== GAME STATE ===\n");
-	printf("Current card: ");
-	printCard(&game -> currentCard);
-	printf("\n");
-	printf("Current player: %s\n", game -> players[game -> currentPlayer].name);
-	printf("Hidden deck: %d cards\n", game -> hiddenDeck -> size);
-	printf("Played deck: %d cards\n", game->playedDeck->size);
-	printf("\n");
-
+	// every hand is full after the deal and only the player whose turn it
+	// is can lose cards, so that is the only hand to look at
+	return game -> players[game -> currentPlayer].hand -> size == 0;
 }
 
-/* --- game flow ---*/
-
 
 /**
- * @brief Advances to next player's turn
+ * @brief Decides whether the turn just played ended the game
  *
- * @param game Game state
+ * The player to move winning comes first, then a stalemate, cycle or error
+ * found during the turn, then the turn cap. Sets game -> gameOver when the game
+ * is over.
+ *
+ * @param game Game state, after a turn and before nextTurn()
+ * @return How the game ended, OUTCOME_NONE if it goes on
 */
 
-/* -- goes to player's next turn -- */
-void nextTurn(GameState* game)
+/* -- check how (and if) the game ended -- */
+GameOutcome checkGameOutcome(GameState* game)
 {
-	game -> currentPlayer = (game -> currentPlayer + 1) % NUM_PLAYERS;
+	if (checkGameOver(game)) {
+		game -> outcome = OUTCOME_WIN;
+	} else if (game -> outcome == OUTCOME_NONE && game -> maxTurns > 0 && game -> turns >= game -> maxTurns) {
+		game -> outcome = OUTCOME_TURN_LIMIT;
+	}
+
+	if (game -> outcome != OUTCOME_NONE) {
+		game -> gameOver = 1;
+	}
+	return game -> outcome;
 }
 
 
 /**
- * @file deck.c
- * @brief Implementation of CardDeck operations
- *
- * This file implements all the CardDeck functions declared in deck.h.
- * The deck uses a singly linked list with head and tail pointers.
+ * @brief Name of a game outcome
  *
- * @author Shrestha Dey
- * @date 25 November 2025
+ * @param outcome Outcome
+ * @return Lower case name, "unknown" for an invalid value
 */
 
-/* -- check if game is over -- */
-int checkGameOver(const GameState* game)
+/* -- outcome as text -- */
+const char* outcomeToString(GameOutcome outcome)
 {
-	for (int i = 0; i < NUM_PLAYERS; i++) {
-		if (game -> players[i].hand -> size == 0) {
-			printf("\n*** %s wins the game! ***\n", game -> players[i].name);
-			return 1;
-		}
+	static const char* const names[NUM_OUTCOMES] = { "none", "win", "stalemate", "cycle", "turn limit", "error" };
+
+	if (outcome < 0 || outcome >= NUM_OUTCOMES) {
+		return "unknown";
 	}
-	return 0;
-}
\ No newline at end of file
+	return names[outcome];
+}
@@ -11,11 +11,36 @@
 #define GAME_H
 
 #include "deck.h"
+#include "eventSink.h"
+#include "hand.h"
 #include "sort.h"
+#include "virtualDeck.h"
 
-#define NUM_PLAYERS 2
+#define NUM_PLAYERS 2	// default number of players
+#define MIN_PLAYERS 2
+#define MAX_PLAYERS 10
 #define INITIAL_HAND_SIZE 8
 #define MAX_HAND_SIZE 20
+#define DEFAULT_MAX_TURNS 1000000	// turn cap of a game unless configured otherwise
+#define DEFAULT_MAX_REPEATS 3	// times a position may come back before the game is a cycle
+#define CYCLE_HISTORY 16	// reshuffle positions remembered for cycle detection
+
+struct GameRecord;
+struct Strategy;
+
+
+/**
+  * @brief How a game ended
+*/
+typedef enum GameOutcome {
+	OUTCOME_NONE = 0,	// still being played, or never started
+	OUTCOME_WIN,	// a player emptied their hand
+	OUTCOME_STALEMATE,	// nobody can play and there is nothing left to draw
+	OUTCOME_CYCLE,	// a reshuffle came back to the same position maxRepeats times
+	OUTCOME_TURN_LIMIT,	// maxTurns turns went by without a winner
+	OUTCOME_ERROR,	// a drawn card could not be added to the hand (out of memory)
+	NUM_OUTCOMES
+} GameOutcome;
 
 
 /**
@@ -24,25 +49,67 @@
 /* --- player --- */
 typedef struct Player{
 	CardDeck* hand; // player's hand
+	HandIndex index; // card counts of the hand, kept in step with hand
 	char name[20]; // player
 } Player;
 
 
+/**
+ * @brief Settings used to create a game, see initGameConfig() for defaults
+*/
+/* --- game config --- */
+typedef struct GameConfig {
+	int numPacks;	// number of card packs in the hidden deck
+	int numPlayers;	// players at the table, MIN_PLAYERS to MAX_PLAYERS
+	uint64_t seed;	// seed for the hidden deck's random stream
+	EventSink* sink;	// receives the game's events, NULL for a silent game
+	NodePool* pool;	// node allocator for all decks, NULL for one owned by the game
+	struct GameRecord* record;	// receives the deal and every move, NULL to not record
+	const struct Strategy* strategies[MAX_PLAYERS];	// strategy of each seat, NULL for the first match
+	int maxTurns;	// turns after which the game is stopped, 0 for no limit
+	int maxRepeats;	// repeats of a position that end the game as a cycle, at least 2 (the first visit counts), 0 to not look for cycles
+	int lazyHiddenDeck;	// set to keep the hidden deck as card counts (a VirtualDeck) instead of shuffled cards
+	int lazyShuffle;	// set to shuffle the hidden deck as it is drawn (shuffleDeckLazy()) instead of up front
+} GameConfig;
+
+
 /**
  * @brief Structure representing the complete game state
 */
 /* --- game state --- */
 typedef struct GameState{
-	Player players[NUM_PLAYERS]; // players
+	Player* players; // players, numPlayers of them
+	int numPlayers;	// players at the table
 	CardDeck* hiddenDeck;	// draw pile (the ones that are face down)
 	CardDeck* playedDeck;	// discarded pile (faced up)
 	Card currentCard;	// current card that is being matched
-	int currentPlayer;	// player number (either 0 or 1 bc theres only 2 players)
+	int currentPlayer;	// player number, 0 to numPlayers-1
 	int gameOver;	 // flag that signifies game over
+	EventSink* sink;	// receives the game's events, NULL for a silent game
+	int turns;	// number of turns taken so far
+	int draws;	// number of cards drawn from the hidden deck after the deal
+	int reshuffles;	// number of times the played deck was recycled
+	NodePool* pool;	// node allocator shared by all the decks above
+	int ownsPool;	// set if pool was created by the game and must be freed with it
+	struct GameRecord* record;	// record being written, NULL if not recording
+	const struct Strategy* strategies[MAX_PLAYERS];	// strategy of each seat, NULL for the first match
+	Rng strategyRng;	// random stream handed to the strategies
+	uint64_t hash;	// Zobrist hash of the position, kept up to date by every move (see zobrist.h)
+	uint64_t pileSums[2 + MAX_PLAYERS];	// card key sum of the hidden deck, the played deck and each hand
+	GameOutcome outcome;	// how the game ended, OUTCOME_NONE while it goes on
+	int maxTurns;	// turn cap, 0 for none
+	int maxRepeats;	// cycle threshold, 0 for none
+	uint64_t reshuffleHashes[CYCLE_HISTORY];	// hash after each of the last reshuffles, by reshuffle count
+	int lazyHiddenDeck;	// set if the hidden cards are counted in virtualHidden, hiddenDeck then stays empty
+	VirtualDeck virtualHidden;	// hidden cards of a lazy game, drawn at random
+	int lazyShuffle;	// set if the hidden deck is shuffled as it is drawn
 } GameState;
 
 /* --- game init and cleanup --- */
 GameState* initGame(int numPacks);
+GameState* initGameSeeded(int numPacks, uint64_t seed);
+void initGameConfig(GameConfig* config, int numPacks, uint64_t seed);
+GameState* initGameWithConfig(const GameConfig* config);
 void freeGame(GameState* game);
 
 /* --- game op ---*/
@@ -52,13 +119,12 @@ int isValidMove(const Card* card, const Card* currentCard);
 int playCard(GameState* game, int playerIndex, int cardIndex);
 void drawCardForPlayer(GameState* game, int playerIndex);
 void reshuffleHiddenDeck(GameState* game);
-
-/* --- display fns ---*/
-void printPlayerHand(int playerIndex, const CardDeck* hand);
-void printGameState(const GameState* game);
+int hiddenDeckSize(const GameState* game);
 
 /* --- game flow ---*/
 void nextTurn(GameState* game);
 int checkGameOver(const GameState* game);
+GameOutcome checkGameOutcome(GameState* game);
+const char* outcomeToString(GameOutcome outcome);
 
-#endif !GAME_H
+#endif // !GAME_H
@@ -0,0 +1,336 @@
+/**
+ * @file gameRecord.c
+ * @brief Recording, binary storage and replay of games
+ *
+ * @author Oluwatunmise Adegbola
+ * @date 17 October 2026
+*/
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gameRecord.h"
+
+#define RECORD_HEADER_SIZE 24
+#define MIN_MOVES 256
+
+static const char recordMagic[4] = { 'C', 'G', 'R', 'C' };
+
+
+/**
+ * @brief Packs the cards each player holds and the current card
+ *
+ * Hands shorter than INITIAL_HAND_SIZE (a deck too small to deal) are
+ * padded with RECORD_NO_CARD.
+ *
+ * @param game Game right after the deal
+ * @param deal Where to store the hands
+ * @param firstCard Where to store the card on the table
+ */
+static void packDeal(const GameState* game, PackedCard deal[MAX_PLAYERS][INITIAL_HAND_SIZE], PackedCard* firstCard)
+{
+	memset(deal, RECORD_NO_CARD, sizeof(PackedCard) * MAX_PLAYERS * INITIAL_HAND_SIZE);
+	for (int p = 0; p < game -> numPlayers; p++) {
+		if (game -> players[p].hand -> size <= INITIAL_HAND_SIZE) {
+			packDeck(game -> players[p].hand, deal[p]);
+		}
+	}
+	*firstCard = isEmpty(game -> playedDeck) ? RECORD_NO_CARD : packCard(game -> currentCard);
+}
+
+
+/**
+ * @brief Stores a 32 bit value little-endian
+ */
+static void putLE32(uint8_t* out, uint32_t value)
+{
+	for (int i = 0; i < 4; i++) {
+		out[i] = (uint8_t)(value >> (8 * i));
+	}
+}
+
+
+/**
+ * @brief Reads a 32 bit little-endian value
+ */
+static uint32_t getLE32(const uint8_t* in)
+{
+	uint32_t value = 0;
+	for (int i = 0; i < 4; i++) {
+		value |= (uint32_t)in[i] << (8 * i);
+	}
+	return value;
+}
+
+
+/**
+ * @brief Creates an empty record
+ */
+void initGameRecord(GameRecord* record)
+{
+	memset(record, 0, sizeof(*record));
+	record -> winner = -1;
+}
+
+
+/**
+ * @brief Frees the move buffer of a record
+ */
+void freeGameRecord(GameRecord* record)
+{
+	free(record -> moves);
+	initGameRecord(record);
+}
+
+
+/**
+ * @brief Clears a record for a new game, keeping its move buffer
+ */
+void startGameRecord(GameRecord* record, int numPacks, int numPlayers, uint64_t seed)
+{
+	record -> seed = seed;
+	record -> numPacks = numPacks;
+	record -> numPlayers = numPlayers;
+	record -> winner = -1;
+	memset(record -> deal, RECORD_NO_CARD, sizeof(record -> deal));
+	record -> firstCard = RECORD_NO_CARD;
+	record -> numMoves = 0;
+	record -> overflow = 0;
+}
+
+
+/**
+ * @brief Stores the dealt hands and the first card
+ */
+void recordDeal(GameRecord* record, const GameState* game)
+{
+	packDeal(game, record -> deal, &record -> firstCard);
+}
+
+
+/**
+ * @brief Doubles the move buffer
+ */
+bool growGameRecord(GameRecord* record)
+{
+	if (record -> capacity > INT_MAX / 2) {
+		return false;
+	}
+
+	int capacity = record -> capacity ? record -> capacity * 2 : MIN_MOVES;
+	uint8_t* moves = realloc(record -> moves, (size_t)capacity);
+	if (!moves) {
+		return false;
+	}
+
+	record -> moves = moves;
+	record -> capacity = capacity;
+	return true;
+}
+
+
+/**
+ * @brief Writes a record in the binary format
+ */
+bool writeGameRecord(FILE* out, const GameRecord* record)
+{
+	uint8_t header[RECORD_HEADER_SIZE];
+	size_t dealBytes = (size_t)record -> numPlayers * INITIAL_HAND_SIZE;
+
+	memcpy(header, recordMagic, sizeof(recordMagic));
+	header[4] = RECORD_VERSION;
+	header[5] = (uint8_t)record -> numPlayers;
+	header[6] = INITIAL_HAND_SIZE;
+	header[7] = record -> winner < 0 ? RECORD_NO_CARD : (uint8_t)record -> winner;
+	putLE32(header + 8, (uint32_t)record -> seed);
+	putLE32(header + 12, (uint32_t)(record -> seed >> 32));
+	putLE32(header + 16, (uint32_t)record -> numPacks);
+	putLE32(header + 20, (uint32_t)record -> numMoves);
+
+	return fwrite(header, 1, sizeof(header), out) == sizeof(header)
+		&& fwrite(record -> deal, 1, dealBytes, out) == dealBytes
+		&& fwrite(&record -> firstCard, 1, 1, out) == 1
+		&& fwrite(record -> moves, 1, (size_t)record -> numMoves, out) == (size_t)record -> numMoves;
+}
+
+
+/**
+ * @brief Reads the next record from a stream
+ */
+int readGameRecord(FILE* in, GameRecord* record)
+{
+	uint8_t header[RECORD_HEADER_SIZE];
+
+	size_t got = fread(header, 1, sizeof(header), in);
+	if (got == 0) {
+		return 0;	// clean end of the stream
+	}
+	if (got != sizeof(header) || memcmp(header, recordMagic, sizeof(recordMagic)) != 0
+		|| header[4] != RECORD_VERSION || header[5] < MIN_PLAYERS || header[5] > MAX_PLAYERS
+		|| header[6] != INITIAL_HAND_SIZE || (header[7] >= header[5] && header[7] != RECORD_NO_CARD)) {
+		return -1;
+	}
+
+	uint32_t numPacks = getLE32(header + 16);
+	uint32_t numMoves = getLE32(header + 20);
+	if (numPacks == 0 || numPacks > INT_MAX || numMoves > INT_MAX) {
+		return -1;
+	}
+
+	startGameRecord(record, (int)numPacks, header[5], (uint64_t)getLE32(header + 8) | ((uint64_t)getLE32(header + 12) << 32));
+	record -> winner = header[7] == RECORD_NO_CARD ? -1 : header[7];
+
+	while (record -> capacity < (int)numMoves) {
+		if (!growGameRecord(record)) {
+			return -1;
+		}
+	}
+
+	size_t dealBytes = (size_t)record -> numPlayers * INITIAL_HAND_SIZE;
+	if (fread(record -> deal, 1, dealBytes, in) != dealBytes
+		|| fread(&record -> firstCard, 1, 1, in) != 1
+		|| fread(record -> moves, 1, numMoves, in) != numMoves) {
+		return -1;
+	}
+	record -> numMoves = (int)numMoves;
+	return 1;
+}
+
+
+/**
+ * @brief Replays the moves of a record on a freshly created game
+ *
+ * Follows the same turn structure as the game loop: deal, which sorts the
+ * hands, then one move per turn with drawn cards inserted in order.
+ *
+ * @param game Game created from the record's seed and packs
+ * @param record Record to check against
+ * @param move Index of the move being replayed, updated as it goes
+ * @return REPLAY_OK, or the first problem found
+ */
+static ReplayStatus replayMoves(GameState* game, const GameRecord* record, int* move)
+{
+	// the deal leaves the hands sorted, so let it record the deal order
+	GameRecord dealt;
+	GameRecord* saved = game -> record;
+	memset(&dealt, 0, sizeof(dealt));
+	game -> record = &dealt;
+	dealInitialCards(game);
+	game -> record = saved;
+	if (memcmp(dealt.deal, record -> deal, sizeof(dealt.deal)) != 0 || dealt.firstCard != record -> firstCard) {
+		return REPLAY_DEAL_MISMATCH;
+	}
+
+	for (*move = 0; *move < record -> numMoves; (*move)++) {
+		if (game -> gameOver) {
+			return REPLAY_WINNER_MISMATCH;	// moves left after the game ended
+		}
+
+		int playerIndex = game -> currentPlayer;
+		Player* player = &game -> players[playerIndex];
+		uint8_t code = record -> moves[*move];
+		game -> turns++;
+
+		if (!(code & MOVE_DRAW)) {
+			if (code >= NUM_CARD_TYPES) {
+				return REPLAY_BAD_RECORD;
+			}
+
+			// the hand is sorted, so the first copy of the card sits where the index says
+			Card card = unpackCard(code);
+			int position = handPositionOf(&player -> index, card);
+			const Card* held = peekCardAt(player -> hand, position);
+			if (!held || compareCards(held, &card) != 0 || !isValidMove(&card, &game -> currentCard)) {
+				return REPLAY_ILLEGAL_PLAY;
+			}
+			playCard(game, playerIndex, position);
+		} else {
+			if (code != MOVE_PASS && (code & MOVE_CARD_MASK) >= NUM_CARD_TYPES) {
+				return REPLAY_BAD_RECORD;
+			}
+			if (handHasMatch(&player -> index, &game -> currentCard)) {
+				return REPLAY_ILLEGAL_DRAW;
+			}
+
+			// the drawn card is inserted in order, so look for it by its count
+			Card expected = unpackCard((PackedCard)(code == MOVE_PASS ? 0 : code & MOVE_CARD_MASK));
+			int heldBefore = player -> index.counts[expected.suit][expected.rank - TWO];
+			int drawsBefore = game -> draws;
+			drawCardForPlayer(game, playerIndex);
+
+			if (game -> draws == drawsBefore) {
+				if (code != MOVE_PASS) {
+					return REPLAY_DRAW_MISMATCH;
+				}
+			} else if (code == MOVE_PASS || player -> index.counts[expected.suit][expected.rank - TWO] != heldBefore + 1) {
+				return REPLAY_DRAW_MISMATCH;
+			}
+		}
+
+		if (checkGameOver(game)) {
+			game -> gameOver = 1;
+			if (playerIndex != record -> winner) {
+				return REPLAY_WINNER_MISMATCH;
+			}
+		} else {
+			nextTurn(game);
+		}
+	}
+
+	// a finished record must end exactly when the game does
+	if (!game -> gameOver && record -> winner >= 0) {
+		return REPLAY_WINNER_MISMATCH;
+	}
+	return REPLAY_OK;
+}
+
+
+/**
+ * @brief Replays a record and checks every turn against it
+ */
+ReplayStatus replayGame(const GameRecord* record, int* failedMove)
+{
+	int move = 0;
+	ReplayStatus status;
+
+	if (record -> overflow) {
+		status = REPLAY_BAD_RECORD;
+	} else {
+		GameConfig config;
+		initGameConfig(&config, record -> numPacks, record -> seed);
+		config.numPlayers = record -> numPlayers;
+		GameState* game = initGameWithConfig(&config);
+
+		if (!game) {
+			status = REPLAY_INIT_FAILED;
+		} else {
+			status = replayMoves(game, record, &move);
+			freeGame(game);
+		}
+	}
+
+	if (failedMove) {
+		*failedMove = move;
+	}
+	return status;
+}
+
+
+/**
+ * @brief Short description of a replay status
+ */
+const char* replayStatusToString(ReplayStatus status)
+{
+	switch (status) {
+	case REPLAY_OK:	return "ok";
+	case REPLAY_INIT_FAILED:	return "game could not be created";
+	case REPLAY_BAD_RECORD:	return "invalid or incomplete record";
+	case REPLAY_DEAL_MISMATCH:	return "dealt cards differ";
+	case REPLAY_ILLEGAL_PLAY:	return "illegal play";
+	case REPLAY_ILLEGAL_DRAW:	return "draw while a card could be played";
+	case REPLAY_DRAW_MISMATCH:	return "drawn card differs";
+	case REPLAY_WINNER_MISMATCH:	return "game ended differently";
+	default:	return "unknown status";
+	}
+}
@@ -0,0 +1,170 @@
+/**
+ * @file gameRecord.h
+ * @brief Compact game records and the replay engine that checks them
+ *
+ * A GameRecord holds everything needed to reproduce a game: its seed and
+ * pack count, the cards each player was dealt, the first card on the
+ * table and one byte per turn saying what the player did. Recording is
+ * switched on by pointing GameConfig.record at a GameRecord; the game
+ * then appends a byte per play or draw into a buffer that is reused from
+ * one game to the next, so it can stay on for whole batch runs.
+ *
+ * replayGame() plays a record back through the normal game functions and
+ * checks at every turn that the recorded move was legal and that the
+ * cards drawn are the ones the seed produces.
+ *
+ * On disk a record is a 24 byte little-endian header, the deal, then the
+ * moves:
+ *
+ *   0  4  magic "CGRC"
+ *   4  1  format version
+ *   5  1  number of players
+ *   6  1  cards dealt to each player
+ *   7  1  winner (0xFF if none)
+ *   8  8  seed
+ *   16 4  number of packs
+ *   20 4  number of moves
+ *   24    players * dealt PackedCards, first card, then the moves
+ *
+ * @author Oluwatunmise Adegbola
+ * @date 17 October 2026
+*/
+
+#ifndef GAMERECORD_H
+#define GAMERECORD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "game.h"
+
+#define RECORD_VERSION 1
+#define RECORD_NO_CARD 0xFF	// deal slot left empty, or no first card
+#define MOVE_DRAW 0x80	// set for a draw, clear for a play; low bits hold the card
+#define MOVE_CARD_MASK 0x3F
+#define MOVE_PASS (MOVE_DRAW | MOVE_CARD_MASK)	// had to draw but nothing was left
+
+/**
+  * @brief Everything needed to replay one game
+*/
+typedef struct GameRecord {
+	uint64_t seed;	// seed the game was created with
+	int numPacks;	// number of card packs
+	int numPlayers;	// number of players
+	int winner;	// winning player, -1 if the game did not finish
+	PackedCard deal[MAX_PLAYERS][INITIAL_HAND_SIZE];	// cards dealt, in deal order (numPlayers rows)
+	PackedCard firstCard;	// first card turned up, RECORD_NO_CARD if none
+	uint8_t* moves;	// one byte per turn, see MOVE_DRAW
+	int numMoves;	// moves recorded
+	int capacity;	// size of the moves buffer
+	int overflow;	// set if a move could not be stored (out of memory)
+} GameRecord;
+
+/**
+  * @brief Result of replaying a record
+*/
+typedef enum ReplayStatus {
+	REPLAY_OK = 0,	// every turn matched and the same player won
+	REPLAY_INIT_FAILED,	// the game could not be created
+	REPLAY_BAD_RECORD,	// the record is incomplete or holds an invalid move byte
+	REPLAY_DEAL_MISMATCH,	// the seed deals different cards
+	REPLAY_ILLEGAL_PLAY,	// card not in hand or not playable on the current card
+	REPLAY_ILLEGAL_DRAW,	// drew although a card could be played
+	REPLAY_DRAW_MISMATCH,	// a different card (or none) was drawn
+	REPLAY_WINNER_MISMATCH	// game ended at another turn or with another winner
+} ReplayStatus;
+
+/**
+  * @brief Creates an empty record
+  *
+  * @param record Record to initialise, cannot be NULL
+*/
+void initGameRecord(GameRecord* record);
+
+/**
+  * @brief Frees the move buffer of a record
+  *
+  * @param record Record to free, cannot be NULL
+*/
+void freeGameRecord(GameRecord* record);
+
+/**
+  * @brief Clears a record for a new game, keeping its move buffer
+  *
+  * @param record Record to reset, cannot be NULL
+  * @param numPacks Number of packs of the new game
+  * @param numPlayers Number of players of the new game
+  * @param seed Seed of the new game
+*/
+void startGameRecord(GameRecord* record, int numPacks, int numPlayers, uint64_t seed);
+
+/**
+  * @brief Stores the cards just dealt and the first card on the table
+  *
+  * @param record Record to update, cannot be NULL
+  * @param game Game right after dealInitialCards()
+*/
+void recordDeal(GameRecord* record, const GameState* game);
+
+/**
+  * @brief Doubles the move buffer, used by recordMove() when it is full
+  *
+  * @param record Record to grow
+  * @return true on success, false on memory allocation failure
+*/
+bool growGameRecord(GameRecord* record);
+
+/**
+  * @brief Appends one move byte
+  *
+  * @param record Record to update, cannot be NULL
+  * @param move Packed card, with MOVE_DRAW set for a draw, or MOVE_PASS
+*/
+static inline void recordMove(GameRecord* record, uint8_t move)
+{
+	if (record -> numMoves == record -> capacity && !growGameRecord(record)) {
+		record -> overflow = 1;
+		return;
+	}
+	record -> moves[record -> numMoves++] = move;
+}
+
+/**
+  * @brief Writes a record in the binary format
+  *
+  * @param out Stream to write to
+  * @param record Record to write
+  * @return true on success, false on a write error
+*/
+bool writeGameRecord(FILE* out, const GameRecord* record);
+
+/**
+  * @brief Reads the next record from a stream
+  *
+  * @param in Stream to read from
+  * @param record Initialised record to fill, its move buffer is reused
+  * @return 1 if a record was read, 0 at the end of the stream, -1 if the
+  *         data is not a valid record
+*/
+int readGameRecord(FILE* in, GameRecord* record);
+
+/**
+  * @brief Replays a record and checks every turn against it
+  *
+  * @param record Record to replay
+  * @param failedMove Where to store the move the replay stopped at
+  *        (numMoves if it ran to the end), may be NULL
+  * @return REPLAY_OK, or the first problem found
+*/
+ReplayStatus replayGame(const GameRecord* record, int* failedMove);
+
+/**
+  * @brief Short description of a replay status
+  *
+  * @param status Status to describe
+  * @return Constant string
+*/
+const char* replayStatusToString(ReplayStatus status);
+
+#endif // !GAMERECORD_H
@@ -11,82 +11,250 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 
-#include "game.h"
+#include "gameRecord.h"
+#include "gameSimulation.h"
+#include "strategy.h"
 
 
 /**
- * @brief Main game loop simulation
+ * @brief Runs the main game loop until someone wins or the game is stopped
  *
- * Runs the complete game according to the specified rules.
+ * Deals, sorts the hands and alternates turns. Everything that happens
+ * is reported to game -> sink; nothing is printed here.
  *
- * @param numPacks Number of card packs to use
+ * @param game Freshly initialised game state
  */
-void simulateGame(int numPacks)
+static void runGameLoop(GameState* game)
 {
-	printf("=== Game Start! ===\n");
-	printf("Using %d pack(s) of cards.\n", numPacks);
-		
-	GameState* game = initGame(numPacks);
-
-	if (!game) {
-		printf("game did not initialise :(\n");
-		return;
-	}
+	EventSink* sink = game -> sink;
 
 	// deal initial cards
 	dealInitialCards(game);
 
-	// sort and shiw players hands
-	for (int i = 0; i < NUM_PLAYERS; i++) {
-		sortDeck(game -> players[i].hand);
-		printPlayerHand(i, game -> players[i].hand);
+	// show players hands, already sorted by the deal
+	for (int i = 0; i < game -> numPlayers; i++) {
+		emitEvent(sink, game, EVENT_HAND, i, NULL, 0);
 	}
 
-	printf("\n=== Let the games begin! ===\n");
-
-	printf("\nInitial card on table: ");
-	printCard(&game -> currentCard);
-	printf("\n\n");
+	emitEvent(sink, game, EVENT_GAME_BEGIN, -1, &game -> currentCard, 0);
 
 	// main game loop
 	while (!game -> gameOver) {
-		Player* currentPlayer = &game -> players[game -> currentPlayer];
+		int playerIndex = game -> currentPlayer;
+		game -> turns++;
 
-		printf("It's %s's turn!\n", currentPlayer -> name);
-		printGameState(game);
-		printPlayerHand(game -> currentPlayer, currentPlayer -> hand);
+		emitEvent(sink, game, EVENT_TURN_START, playerIndex, NULL, 0);
+		emitEvent(sink, game, EVENT_STATE, playerIndex, NULL, 0);
+		emitEvent(sink, game, EVENT_HAND, playerIndex, NULL, 0);
 
 		// check for matching card
-		int matchingCardIndex = findMatchingCard(game, game -> currentPlayer);
+		int matchingCardIndex = chooseCardToPlay(game, playerIndex);
 
 		if (matchingCardIndex != -1) {
-			printf("%s plays a card from their hand!\n", currentPlayer -> name);
 			//play the matching card
-			playCard(game, game -> currentPlayer, matchingCardIndex);
+			playCard(game, playerIndex, matchingCardIndex);
 		} else {
-			printf("%s has no matching card and must draw!\n", currentPlayer -> name);
+			emitEvent(sink, game, EVENT_NO_MATCH, playerIndex, NULL, 0);
 			// no mathcing card, boohoo, draw from hidden deck
-			drawCardForPlayer(game, game -> currentPlayer);
-
-			// sort hand after drawing
-			sortDeck(currentPlayer -> hand);
+			drawCardForPlayer(game, playerIndex);	// the drawn card is inserted in order
 		}
 
 		// print new hand
-		printPlayerHand(game -> currentPlayer, currentPlayer -> hand);
+		emitEvent(sink, game, EVENT_HAND, playerIndex, NULL, 0);
 
 		//check if gam'es over
-		if (checkGameOver(game)) {
-			game -> gameOver = 1;
-			printf("Game Over! %s wins!\n", currentPlayer -> name);
+		GameOutcome outcome = checkGameOutcome(game);
+		if (outcome == OUTCOME_WIN) {
+			if (game -> record) {
+				game -> record -> winner = playerIndex;
+			}
+			emitEvent(sink, game, EVENT_WIN, playerIndex, NULL, 0);
+		} else if (outcome != OUTCOME_NONE) {
+			// stalemate, cycle or turn cap: the game stops with no winner
+			emitEvent(sink, game, EVENT_NO_WINNER, -1, NULL, (int)outcome);
 		} else {
 			// next turn
 			nextTurn(game);
-			printf("\n");
+			emitEvent(sink, game, EVENT_TURN_END, playerIndex, NULL, 0);
 		}
 	}
-	
+}
+
+
+/**
+ * @brief Main game loop simulation
+ *
+ * Runs the complete game according to the specified rules.
+ *
+ * @param numPacks Number of card packs to use
+ */
+void simulateGame(int numPacks)
+{
+	GameResult result;
+	playGame(numPacks, NUM_PLAYERS, (unsigned long long)time(NULL), VERBOSITY_FULL, &result);
+}
+
+
+/**
+ * @brief Plays one complete game and reports its result
+ *
+ * @param numPacks Number of card packs to use
+ * @param numPlayers Number of players
+ * @param seed Seed for the shuffles
+ * @param verbosity How much of the game to print on stdout
+ * @param result Where to store the outcome
+ * @return 1 if the game was played, 0 otherwise
+ */
+int playGame(int numPacks, int numPlayers, unsigned long long seed, Verbosity verbosity, GameResult* result)
+{
+	GameConfig config;
+	initGameConfig(&config, numPacks, (uint64_t)seed);
+	config.numPlayers = numPlayers;
+
+	if (verbosity > VERBOSITY_SILENT) {
+		config.sink = createTextSink(stdout, verbosity);
+	}
+
+	int played = playGameWithConfig(&config, result);
+	freeSink(config.sink);
+	return played;
+}
+
+
+/**
+ * @brief Plays one complete game from a configuration
+ *
+ * @param config Game settings
+ * @param result Where to store the outcome
+ * @return 1 if the game was played, 0 otherwise
+ */
+int playGameWithConfig(const GameConfig* config, GameResult* result)
+{
+	result -> winner = -1;
+	result -> outcome = OUTCOME_NONE;
+	result -> turns = 0;
+	result -> draws = 0;
+	result -> reshuffles = 0;
+
+	emitEvent(config -> sink, NULL, EVENT_GAME_START, -1, NULL, config -> numPacks);
+
+	GameState* game = initGameWithConfig(config);
+
+	if (!game) {
+		emitEvent(config -> sink, NULL, EVENT_INIT_FAILED, -1, NULL, 0);
+		return 0;
+	}
+
+	runGameLoop(game);
+
+	result -> outcome = game -> outcome;
+	result -> winner = game -> outcome == OUTCOME_WIN ? game -> currentPlayer : -1;
+	result -> turns = game -> turns;
+	result -> draws = game -> draws;
+	result -> reshuffles = game -> reshuffles;
+
 	freeGame(game);
-	printf("=== Game Over! ===\n");
-}
\ No newline at end of file
+	emitEvent(config -> sink, NULL, EVENT_GAME_END, -1, NULL, 0);
+	return 1;
+}
+
+
+/**
+ * @brief Plays a batch of games silently
+ *
+ * @param numPacks Number of card packs to use
+ * @param numPlayers Number of players
+ * @param seed Seed of the first game
+ * @param numGames Number of games to play
+ * @param results Array of at least numGames results
+ * @return Number of games that were played
+ */
+int runGames(int numPacks, int numPlayers, unsigned long long seed, int numGames, GameResult* results)
+{
+	int played = 0;
+
+	for (int i = 0; i < numGames; i++) {
+		played += playGame(numPacks, numPlayers, seed + (unsigned long long)i, VERBOSITY_SILENT, &results[i]);
+	}
+
+	return played;
+}
+
+
+/**
+ * @brief Resets batch totals to zero
+ *
+ * @param stats Totals to reset
+ */
+void initBatchStats(BatchStats* stats)
+{
+	memset(stats, 0, sizeof(*stats));
+}
+
+
+/**
+ * @brief Adds the outcome of one game to batch totals
+ *
+ * @param stats Totals to update
+ * @param result Outcome of a played game
+ */
+void addGameResult(BatchStats* stats, const GameResult* result)
+{
+	if (result -> outcome == OUTCOME_NONE) {
+		stats -> failed++;
+		return;
+	}
+
+	stats -> games++;
+	stats -> outcomes[result -> outcome]++;
+	if (result -> outcome == OUTCOME_WIN) {
+		stats -> wins[result -> winner]++;
+	}
+	stats -> turns += result -> turns;
+	stats -> draws += result -> draws;
+	stats -> reshuffles += result -> reshuffles;
+	if (result -> turns > stats -> maxTurns) {
+		stats -> maxTurns = result -> turns;
+	}
+
+	addRunningStat(&stats -> turnStats, result -> turns);
+	addRunningStat(&stats -> drawStats, result -> draws);
+	addRunningStat(&stats -> reshuffleStats, result -> reshuffles);
+	addToHistogram(&stats -> turnHistogram, result -> turns);
+	addToHistogram(&stats -> drawHistogram, result -> draws);
+	addToHistogram(&stats -> reshuffleHistogram, result -> reshuffles);
+}
+
+
+/**
+ * @brief Adds one set of batch totals into another
+ *
+ * @param into Totals to update
+ * @param from Totals to add
+ */
+void mergeBatchStats(BatchStats* into, const BatchStats* from)
+{
+	into -> games += from -> games;
+	into -> failed += from -> failed;
+	for (int i = 0; i < MAX_PLAYERS; i++) {
+		into -> wins[i] += from -> wins[i];
+	}
+	for (int i = 0; i < NUM_OUTCOMES; i++) {
+		into -> outcomes[i] += from -> outcomes[i];
+	}
+	into -> turns += from -> turns;
+	into -> draws += from -> draws;
+	into -> reshuffles += from -> reshuffles;
+	if (from -> maxTurns > into -> maxTurns) {
+		into -> maxTurns = from -> maxTurns;
+	}
+
+	mergeRunningStat(&into -> turnStats, &from -> turnStats);
+	mergeRunningStat(&into -> drawStats, &from -> drawStats);
+	mergeRunningStat(&into -> reshuffleStats, &from -> reshuffleStats);
+	mergeHistogram(&into -> turnHistogram, &from -> turnHistogram);
+	mergeHistogram(&into -> drawHistogram, &from -> drawHistogram);
+	mergeHistogram(&into -> reshuffleHistogram, &from -> reshuffleHistogram);
+}
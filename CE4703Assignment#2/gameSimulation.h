@@ -2,7 +2,9 @@
  * @file gameSimulation.h
  * @brief Main game loop simulation
  *
- * This file defines the game simulation method.
+ * This file defines the game simulation method, plus a quiet engine
+ * entry point that plays games without printing and reports the outcome
+ * of each one in a GameResult.
  *
  * @author Oluwatunmise Adegbola
  * @date 26 November 2025
@@ -14,11 +16,111 @@
 #include "game.h"
 #include "deck.h"
 #include "sort.h"
+#include "statistics.h"
+
+/**
+  * @brief Outcome of one simulated game
+*/
+typedef struct GameResult {
+	int winner;	// index of the winning player, -1 if nobody won or the game did not start
+	GameOutcome outcome;	// how the game ended, OUTCOME_NONE if it did not start
+	int turns;	// number of turns played
+	int draws;	// cards drawn from the hidden deck after the deal
+	int reshuffles;	// number of times the played deck was recycled
+} GameResult;
+
+/**
+  * @brief Totals over a batch of games
+  *
+  * The counts, sums and histograms are exact integers, so merging the
+  * totals of several workers gives the same numbers whatever order they
+  * are merged in. The running moments (see statistics.h) agree to
+  * rounding and are merged in worker order, so a given thread count
+  * always gives the same bits. The size does not grow with the number
+  * of games.
+*/
+typedef struct BatchStats {
+	long long games;	// games played
+	long long failed;	// games that could not be initialised
+	long long wins[MAX_PLAYERS];	// wins per seat
+	long long outcomes[NUM_OUTCOMES];	// games per way of ending
+	long long turns;	// total turns over all games
+	long long draws;	// total draws over all games
+	long long reshuffles;	// total reshuffles over all games
+	int maxTurns;	// longest game seen
+	RunningStat turnStats;	// mean and spread of the turns per game
+	RunningStat drawStats;	// mean and spread of the draws per game
+	RunningStat reshuffleStats;	// mean and spread of the reshuffles per game
+	Histogram turnHistogram;	// distribution of the turns per game
+	Histogram drawHistogram;	// distribution of the draws per game
+	Histogram reshuffleHistogram;	// distribution of the reshuffles per game
+} BatchStats;
 
 /**
   * @brief Method running the complete card game.
 */
 void simulateGame(int numPacks);
 
-#endif // !GAMESIMULATION_H
+/**
+  * @brief Plays one complete game and reports its result.
+  *
+  * @param numPacks Number of card packs to use
+  * @param numPlayers Number of players, MIN_PLAYERS to MAX_PLAYERS
+  * @param seed Seed for the shuffles, the same seed replays the same game
+  * @param verbosity How much of the game to print on stdout
+  * @param result Where to store the outcome, cannot be NULL
+  * @return 1 if the game was played, 0 if it could not be initialised
+*/
+int playGame(int numPacks, int numPlayers, unsigned long long seed, Verbosity verbosity, GameResult* result);
+
+/**
+  * @brief Plays one complete game from a configuration.
+  *
+  * Same as playGame(), but every GameConfig setting is available, such as
+  * a NodePool reused across games.
+  *
+  * @param config Game settings, cannot be NULL
+  * @param result Where to store the outcome, cannot be NULL
+  * @return 1 if the game was played, 0 if it could not be initialised
+*/
+int playGameWithConfig(const GameConfig* config, GameResult* result);
 
+/**
+  * @brief Plays a batch of games silently.
+  *
+  * Game i is seeded with seed + i, so each game of a batch can be
+  * replayed on its own with playGame().
+  *
+  * @param numPacks Number of card packs to use
+  * @param numPlayers Number of players
+  * @param seed Seed of the first game
+  * @param numGames Number of games to play
+  * @param results Array of at least numGames results, cannot be NULL
+  * @return Number of games that were played
+*/
+int runGames(int numPacks, int numPlayers, unsigned long long seed, int numGames, GameResult* results);
+
+/**
+  * @brief Resets batch totals to zero.
+  *
+  * @param stats Totals to reset, cannot be NULL
+*/
+void initBatchStats(BatchStats* stats);
+
+/**
+  * @brief Adds the outcome of one game to batch totals.
+  *
+  * @param stats Totals to update, cannot be NULL
+  * @param result Outcome of a played game, cannot be NULL
+*/
+void addGameResult(BatchStats* stats, const GameResult* result);
+
+/**
+  * @brief Adds one set of batch totals into another.
+  *
+  * @param into Totals to update, cannot be NULL
+  * @param from Totals to add, cannot be NULL
+*/
+void mergeBatchStats(BatchStats* into, const BatchStats* from);
+
+#endif // !GAMESIMULATION_H
@@ -0,0 +1,214 @@
+/**
+ * @file gameSnapshot.c
+ * @brief Flat copies of a game position
+ *
+ * @author Oluwatunmise Adegbola
+ * @date 17 October 2026
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gameSnapshot.h"
+#include "zobrist.h"
+
+
+/**
+ * @brief Replaces every card of a deck
+ *
+ * The old nodes go back to the deck's pool and are taken again by the
+ * new cards, so this allocates nothing once the pool is warm.
+ *
+ * @param deck Deck to refill
+ * @param cards New cards, top first
+ * @param count Number of cards
+ * @return true on success, false on memory failure
+ */
+static bool loadDeck(CardDeck* deck, const PackedCard* cards, int count)
+{
+	Card removed;
+	deck -> unshuffled = 0;	// no point shuffling cards that are dropped
+	while (removeTopCard(deck, &removed)) {
+	}
+	return addPackedCards(deck, cards, count);
+}
+
+
+/**
+ * @brief Size of a snapshot block
+ */
+size_t gameSnapshotSize(int numPacks)
+{
+	return sizeof(GameSnapshot) + (size_t)numPacks * CARDS_PER_PACK * sizeof(PackedCard);
+}
+
+
+/**
+ * @brief Allocates an empty snapshot
+ */
+GameSnapshot* createGameSnapshot(int numPacks, int numPlayers)
+{
+	if (numPacks < 1 || numPacks > INT32_MAX / CARDS_PER_PACK
+		|| numPlayers < MIN_PLAYERS || numPlayers > MAX_PLAYERS) {
+		return NULL;
+	}
+
+	size_t bytes = gameSnapshotSize(numPacks);
+	GameSnapshot* snapshot = calloc(1, bytes);
+	if (!snapshot) {
+		return NULL;
+	}
+
+	snapshot -> bytes = bytes;
+	snapshot -> numPacks = numPacks;
+	snapshot -> numPlayers = numPlayers;
+	return snapshot;
+}
+
+
+/**
+ * @brief Frees a snapshot
+ */
+void freeGameSnapshot(GameSnapshot* snapshot)
+{
+	free(snapshot);
+}
+
+
+/**
+ * @brief Copies a game position into a snapshot
+ */
+bool snapshotGame(const GameState* game, GameSnapshot* snapshot)
+{
+	const CardDeck* piles[SNAPSHOT_MAX_PILES];
+	int numPiles = SNAPSHOT_HAND(game -> numPlayers);
+	long long total = 0;
+
+	piles[SNAPSHOT_HIDDEN] = game -> hiddenDeck;
+	piles[SNAPSHOT_PLAYED] = game -> playedDeck;
+	for (int p = 0; p < game -> numPlayers; p++) {
+		piles[SNAPSHOT_HAND(p)] = game -> players[p].hand;
+	}
+	for (int i = 0; i < numPiles; i++) {
+		total += piles[i] -> size;
+	}
+	total += game -> lazyHiddenDeck ? game -> virtualHidden.size : 0;	// the hidden CardDeck is empty then
+
+	// every card of the game is in exactly one pile
+	if (game -> numPlayers != snapshot -> numPlayers
+		|| total != (long long)snapshot -> numPacks * CARDS_PER_PACK) {
+		return false;
+	}
+
+	PackedCard* out = snapshot -> cards;
+	for (int i = 0; i < SNAPSHOT_MAX_PILES; i++) {
+		if (i == SNAPSHOT_HIDDEN && game -> lazyHiddenDeck) {
+			snapshot -> pileSizes[i] = packVirtualDeck(&game -> virtualHidden, out);
+		} else {
+			snapshot -> pileSizes[i] = i < numPiles ? packDeck(piles[i], out) : 0;
+		}
+		out += snapshot -> pileSizes[i];
+	}
+
+	snapshot -> currentPlayer = game -> currentPlayer;
+	snapshot -> gameOver = game -> gameOver;
+	snapshot -> outcome = game -> outcome;
+	snapshot -> turns = game -> turns;
+	snapshot -> draws = game -> draws;
+	snapshot -> reshuffles = game -> reshuffles;
+	snapshot -> currentCard = game -> currentCard;
+	snapshot -> deckRng = game -> lazyHiddenDeck ? game -> virtualHidden.rng : game -> hiddenDeck -> rng;
+	snapshot -> hiddenUnshuffled = game -> lazyHiddenDeck ? 0 : game -> hiddenDeck -> unshuffled;
+	snapshot -> strategyRng = game -> strategyRng;
+	return true;
+}
+
+
+/**
+ * @brief Puts a game back into the position stored in a snapshot
+ */
+bool restoreGame(GameState* game, const GameSnapshot* snapshot)
+{
+	long long total = (long long)hiddenDeckSize(game) + game -> playedDeck -> size;
+	for (int p = 0; p < game -> numPlayers; p++) {
+		total += game -> players[p].hand -> size;
+	}
+	if (game -> numPlayers != snapshot -> numPlayers
+		|| total != (long long)snapshot -> numPacks * CARDS_PER_PACK) {
+		return false;
+	}
+
+	const PackedCard* cards = snapshot -> cards;
+	if (game -> lazyHiddenDeck) {
+		loadVirtualDeck(&game -> virtualHidden, cards, snapshot -> pileSizes[SNAPSHOT_HIDDEN]);
+	} else if (!loadDeck(game -> hiddenDeck, cards, snapshot -> pileSizes[SNAPSHOT_HIDDEN])) {
+		return false;
+	}
+	cards += snapshot -> pileSizes[SNAPSHOT_HIDDEN];
+	if (!loadDeck(game -> playedDeck, cards, snapshot -> pileSizes[SNAPSHOT_PLAYED])) {
+		return false;
+	}
+	cards += snapshot -> pileSizes[SNAPSHOT_PLAYED];
+
+	for (int p = 0; p < game -> numPlayers; p++) {
+		Player* player = &game -> players[p];
+		int size = snapshot -> pileSizes[SNAPSHOT_HAND(p)];
+		if (!loadDeck(player -> hand, cards, size)) {
+			return false;
+		}
+		initHandIndex(&player -> index);
+		for (int i = 0; i < size; i++) {
+			handIndexAdd(&player -> index, unpackCard(cards[i]));
+		}
+		cards += size;
+	}
+
+	game -> currentPlayer = snapshot -> currentPlayer;
+	game -> gameOver = snapshot -> gameOver;
+	game -> outcome = snapshot -> outcome;
+	game -> turns = snapshot -> turns;
+	game -> draws = snapshot -> draws;
+	game -> reshuffles = snapshot -> reshuffles;
+	game -> currentCard = snapshot -> currentCard;
+	if (game -> lazyHiddenDeck) {
+		game -> virtualHidden.rng = snapshot -> deckRng;
+	} else {
+		// the cards are stored before the rest of a lazy shuffle, so it picks up where it was
+		game -> hiddenDeck -> rng = snapshot -> deckRng;
+		game -> hiddenDeck -> unshuffled = snapshot -> hiddenUnshuffled;
+		if (snapshot -> hiddenUnshuffled > 1) {
+			game -> hiddenDeck -> sorted = false;
+		}
+	}
+	game -> strategyRng = snapshot -> strategyRng;
+	memset(game -> reshuffleHashes, 0, sizeof(game -> reshuffleHashes));
+	rehashGame(game);
+	return true;
+}
+
+
+/**
+ * @brief Copies one snapshot over another of the same size
+ */
+bool copyGameSnapshot(GameSnapshot* dest, const GameSnapshot* src)
+{
+	if (dest -> bytes != src -> bytes) {
+		return false;
+	}
+	memcpy(dest, src, src -> bytes);
+	return true;
+}
+
+
+/**
+ * @brief Allocates a copy of a snapshot
+ */
+GameSnapshot* cloneGameSnapshot(const GameSnapshot* src)
+{
+	GameSnapshot* copy = malloc(src -> bytes);
+	if (copy) {
+		memcpy(copy, src, src -> bytes);
+	}
+	return copy;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file gameSnapshot.h
+ * @brief Flat copies of a game position for search and what-if analysis
+ *
+ * A GameState keeps its decks as linked lists, so copying one means
+ * rebuilding every list node by node. A GameSnapshot holds the same
+ * position in one contiguous block: the counters, the random streams and
+ * every card of the game as a PackedCard. Cards are never created or
+ * destroyed during a game, so the block always holds numPacks * 52 cards,
+ * stored pile after pile (hidden deck, played deck, then each hand), each
+ * pile top card first. Its size is fixed by the pack count, and copying
+ * a snapshot is a single memcpy.
+ *
+ * snapshotGame() and restoreGame() convert between the two forms; search
+ * code snapshots a position once, clones it as often as it likes and
+ * restores a clone into a scratch GameState to play it on.
+ *
+ * A lazy hidden deck (GameConfig::lazyHiddenDeck) has no order and is
+ * stored in card type order; restoring it into a lazy game gives back the
+ * same counts, restoring it into an eager game gives a sorted draw pile.
+ *
+ * A hidden deck shuffled with GameConfig::lazyShuffle is stored in its
+ * order before the rest of the shuffle, with the number of cards still to
+ * shuffle in, so taking a snapshot never touches the game and a restored
+ * game draws the same cards the original would.
+ *
+ * @author Oluwatunmise Adegbola
+ * @date 17 October 2026
+*/
+
+#ifndef GAMESNAPSHOT_H
+#define GAMESNAPSHOT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "game.h"
+
+#define SNAPSHOT_HIDDEN 0	// pile index of the hidden deck
+#define SNAPSHOT_PLAYED 1	// pile index of the played deck
+#define SNAPSHOT_HAND(p) (2 + (p))	// pile index of player p's hand
+#define SNAPSHOT_MAX_PILES (2 + MAX_PLAYERS)
+
+/**
+  * @brief A game position in one flat block
+*/
+typedef struct GameSnapshot {
+	size_t bytes;	// size of the whole block, header included
+	int numPacks;	// card packs in the game
+	int numPlayers;	// players at the table
+	int currentPlayer;	// player to move
+	int gameOver;	// set once the game has ended
+	GameOutcome outcome;	// how it ended, OUTCOME_NONE while it goes on
+	int turns;	// turns taken so far
+	int draws;	// cards drawn after the deal
+	int reshuffles;	// times the played deck was recycled
+	Card currentCard;	// card to match
+	Rng deckRng;	// random stream of the hidden deck
+	int hiddenUnshuffled;	// cards of the hidden deck a lazy shuffle has still to shuffle in
+	Rng strategyRng;	// random stream of the strategies
+	int pileSizes[SNAPSHOT_MAX_PILES];	// cards in each pile, see SNAPSHOT_HAND()
+	PackedCard cards[];	// numPacks * 52 cards, pile after pile, top first
+} GameSnapshot;
+
+/**
+  * @brief Size of a snapshot block
+  *
+  * @param numPacks Number of card packs
+  * @return Bytes needed for a snapshot of a game with that many packs
+*/
+size_t gameSnapshotSize(int numPacks);
+
+/**
+  * @brief Allocates an empty snapshot for games of one size
+  *
+  * @param numPacks Number of card packs of the games it will hold
+  * @param numPlayers Number of players, MIN_PLAYERS to MAX_PLAYERS
+  * @return New snapshot, or NULL on invalid sizes or memory failure
+*/
+GameSnapshot* createGameSnapshot(int numPacks, int numPlayers);
+
+/**
+  * @brief Frees a snapshot
+  *
+  * @param snapshot Snapshot to free, may be NULL
+*/
+void freeGameSnapshot(GameSnapshot* snapshot);
+
+/**
+  * @brief Copies a game position into a snapshot
+  *
+  * @param game Game to copy, cannot be NULL
+  * @param snapshot Snapshot created for the game's pack and player count
+  * @return true on success, false if the sizes do not match
+*/
+bool snapshotGame(const GameState* game, GameSnapshot* snapshot);
+
+/**
+  * @brief Puts a game back into the position stored in a snapshot
+  *
+  * The game keeps its sink, record, strategies and node pool; its decks,
+  * hand indexes, counters, outcome, random streams and hash are replaced,
+  * and the reshuffle history used to find cycles is cleared. Nodes come
+  * from the game's pool, so after the first restore no memory is
+  * allocated.
+  *
+  * @param game Game with the same pack and player count, cannot be NULL
+  * @param snapshot Position to restore, cannot be NULL
+  * @return true on success, false if the sizes do not match or memory ran out
+*/
+bool restoreGame(GameState* game, const GameSnapshot* snapshot);
+
+/**
+  * @brief Copies one snapshot over another of the same size
+  *
+  * @param dest Snapshot to overwrite, cannot be NULL
+  * @param src Snapshot to copy, cannot be NULL
+  * @return true on success, false if the two blocks differ in size
+*/
+bool copyGameSnapshot(GameSnapshot* dest, const GameSnapshot* src);
+
+/**
+  * @brief Allocates a copy of a snapshot
+  *
+  * @param src Snapshot to copy, cannot be NULL
+  * @return New snapshot, or NULL on memory failure
+*/
+GameSnapshot* cloneGameSnapshot(const GameSnapshot* src);
+
+/**
+  * @brief Cards of one pile of a snapshot
+  *
+  * @param snapshot Snapshot to look into
+  * @param pile SNAPSHOT_HIDDEN, SNAPSHOT_PLAYED or SNAPSHOT_HAND(p)
+  * @return First (top) card of the pile, pileSizes[pile] cards long
+*/
+static inline const PackedCard* snapshotPile(const GameSnapshot* snapshot, int pile)
+{
+	const PackedCard* cards = snapshot -> cards;
+	for (int i = 0; i < pile; i++) {
+		cards += snapshot -> pileSizes[i];
+	}
+	return cards;
+}
+
+#endif // !GAMESNAPSHOT_H
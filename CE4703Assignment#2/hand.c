@@ -0,0 +1,147 @@
+/**
+ * @file hand.c
+ * @brief Implementation of the HandIndex operations
+ *
+ * Every function touches at most the 4 suits and 13 ranks of one suit,
+ * so the cost does not depend on how many cards the hand holds.
+ *
+ * @author Shrestha Dey
+ * @date 17 October 2026
+ */
+#include "hand.h"
+#include <string.h>
+
+/**
+ * @brief Empties a hand index
+ */
+void initHandIndex(HandIndex* hand)
+{
+    memset(hand, 0, sizeof(*hand));
+}
+
+/**
+ * @brief Records one more copy of a card
+ */
+void handIndexAdd(HandIndex* hand, Card card)
+{
+    int s = (int)card.suit;
+    int r = (int)card.rank - TWO;
+
+    hand->counts[s][r]++;
+    hand->suitTotals[s]++;
+    hand->suitMasks[s] |= (uint16_t)(1u << r);
+    hand->size++;
+}
+
+/**
+ * @brief Records that one copy of a card left the hand
+ */
+bool handIndexRemove(HandIndex* hand, Card card)
+{
+    int s = (int)card.suit;
+    int r = (int)card.rank - TWO;
+
+    if (hand->counts[s][r] == 0) {
+        return false;
+    }
+
+    /// Clear the presence bit when the last copy goes
+    if (--hand->counts[s][r] == 0) {
+        hand->suitMasks[s] &= (uint16_t)~(1u << r);
+    }
+    hand->suitTotals[s]--;
+    hand->size--;
+    return true;
+}
+
+/**
+ * @brief Checks in O(1) whether any held card matches a suit or rank
+ */
+bool handHasMatch(const HandIndex* hand, const Card* current)
+{
+    uint16_t rankBit = (uint16_t)(1u << ((int)current->rank - TWO));
+    uint16_t anySuit = hand->suitMasks[0] | hand->suitMasks[1]
+        | hand->suitMasks[2] | hand->suitMasks[3];
+
+    return hand->suitMasks[current->suit] != 0 || (anySuit & rankBit) != 0;
+}
+
+/**
+ * @brief Finds the first matching card in sorted order
+ *
+ * In (suit, rank) order the first match is either the same rank in a
+ * lower suit, the lowest rank of the current suit, or the same rank in a
+ * higher suit, so only one candidate per suit has to be checked.
+ */
+int handFirstMatch(const HandIndex* hand, const Card* current, Card* out_card)
+{
+    uint16_t rankBit = (uint16_t)(1u << ((int)current->rank - TWO));
+
+    for (int s = 0; s < NUM_SUITS; s++) {
+        uint16_t mask = hand->suitMasks[s];
+        Card match;
+
+        if (s == (int)current->suit) {
+            if (mask == 0) {
+                continue;
+            }
+            /// Lowest rank held in the current suit
+            int r = 0;
+            while (!(mask & (1u << r))) {
+                r++;
+            }
+            match.suit = (Suit)s;
+            match.rank = (Rank)(r + TWO);
+        }
+        else if (mask & rankBit) {
+            match.suit = (Suit)s;
+            match.rank = current->rank;
+        }
+        else {
+            continue;
+        }
+
+        if (out_card) {
+            *out_card = match;
+        }
+        return handPositionOf(hand, match);
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Returns where the first copy of a card sits in the sorted hand
+ */
+int handPositionOf(const HandIndex* hand, Card card)
+{
+    int s = (int)card.suit;
+    int r = (int)card.rank - TWO;
+    int position = 0;
+
+    for (int i = 0; i < s; i++) {
+        position += hand->suitTotals[i];
+    }
+    for (int i = 0; i < r; i++) {
+        position += hand->counts[s][i];
+    }
+    return position;
+}
+
+/**
+ * @brief Writes the hand out in sorted order
+ */
+int listHandCards(const HandIndex* hand, Card* out, int max_cards)
+{
+    int written = 0;
+
+    for (int s = 0; s < NUM_SUITS; s++) {
+        for (int r = 0; r < NUM_RANKS; r++) {
+            Card card = { (Suit)s, (Rank)(r + TWO) };
+            for (int n = hand->counts[s][r]; n > 0 && written < max_cards; n--) {
+                out[written++] = card;
+            }
+        }
+    }
+    return written;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file hand.h
+ * @brief HandIndex type: count-vector and bitmask view of a player's hand
+ *
+ * A HandIndex records how many copies of each of the 52 cards a hand
+ * holds, plus one 13-bit mask per suit with a bit set for every rank that
+ * is present. It is kept up to date card by card, and answers "is there
+ * a card matching this suit or rank" with a couple of mask operations
+ * instead of a walk over the hand.
+ *
+ * Sorted order is the compareCards() order used by sortDeck().
+ *
+ * @author Shrestha Dey
+ * @date 17 October 2026
+ */
+
+#pragma once
+#ifndef HAND_H
+#define HAND_H
+
+#include "card.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define NUM_SUITS 4
+#define NUM_RANKS 13
+
+/**
+ * @brief Count-vector and per-suit presence masks of a hand
+ */
+typedef struct {
+    int counts[NUM_SUITS][NUM_RANKS];  ///< Copies held of each (suit, rank)
+    int suitTotals[NUM_SUITS];         ///< Cards held of each suit
+    uint16_t suitMasks[NUM_SUITS];     ///< Bit (rank - TWO) set if that rank is held in the suit
+    int size;                          ///< Total number of cards held
+} HandIndex;
+
+/**
+ * @brief Empties a hand index
+ *
+ * @param hand Index to reset, cannot be NULL
+ */
+void initHandIndex(HandIndex* hand);
+
+/**
+ * @brief Records one more copy of a card
+ *
+ * @param hand Index to update, cannot be NULL
+ * @param card Card added to the hand
+ */
+void handIndexAdd(HandIndex* hand, Card card);
+
+/**
+ * @brief Records that one copy of a card left the hand
+ *
+ * @param hand Index to update, cannot be NULL
+ * @param card Card removed from the hand
+ * @return true if the card was held, false if there was no copy to remove
+ */
+bool handIndexRemove(HandIndex* hand, Card card);
+
+/**
+ * @brief Checks in O(1) whether any held card matches a suit or rank
+ *
+ * @param hand Index to query, cannot be NULL
+ * @param current Card to match (same suit or same rank), cannot be NULL
+ * @return true if at least one held card can be played on current
+ */
+bool handHasMatch(const HandIndex* hand, const Card* current);
+
+/**
+ * @brief Finds the first matching card in sorted order
+ *
+ * Gives the same card findMatchingCard() would find by scanning a sorted
+ * hand, in a bounded number of steps whatever the hand size.
+ *
+ * @param hand Index to query, cannot be NULL
+ * @param current Card to match, cannot be NULL
+ * @param out_card Where to store the matching card, may be NULL
+ * @return Position of that card in the sorted hand, or -1 if none matches
+ */
+int handFirstMatch(const HandIndex* hand, const Card* current, Card* out_card);
+
+/**
+ * @brief Returns where the first copy of a card sits in the sorted hand
+ *
+ * If the card is not held, this is the position it would be inserted at.
+ *
+ * @param hand Index to query, cannot be NULL
+ * @param card Card to locate
+ * @return Number of held cards that sort before card
+ */
+int handPositionOf(const HandIndex* hand, Card card);
+
+/**
+ * @brief Writes the hand out in sorted order
+ *
+ * This is the listing the text sink shows for a sorted hand.
+ *
+ * @param hand Index to list, cannot be NULL
+ * @param out Array to fill, cannot be NULL
+ * @param max_cards Capacity of out
+ * @return Number of cards written (at most max_cards)
+ */
+int listHandCards(const HandIndex* hand, Card* out, int max_cards);
+
+#endif
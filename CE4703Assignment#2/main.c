@@ -1,22 +1,450 @@
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
+#include "counters.h"
 #include "game.h"
+#include "gameRecord.h"
 #include "gameSimulation.h"
+#include "mcts.h"
+#include "parallelSimulation.h"
+#include "profiler.h"
+#include "strategy.h"
 
-int main()
+/**
+ * @brief Prints the command line options
+ *
+ * @param program Name the program was started with
+ */
+static void printUsage(const char* program)
 {
-	int numPacks;
+	printf("Usage: %s [--games N] [--packs N] [--players N] [--seed N] [--threads N] [--strategy LIST] [--mcts-ms N] [--mcts-iterations N] [--mcts-threads N] [--max-turns N] [--max-repeats N] [--verbosity LEVEL] [--quiet] [--batch] [--stats] [--lazy-deck] [--lazy-shuffle]\n", program);
+	printf("       %s --replay FILE\n", program);
+	printf("  --games N   number of games to play (default 1)\n");
+	printf("  --packs N   number of card packs to use (default 1)\n");
+	printf("  --players N number of players, %d to %d (default %d)\n", MIN_PLAYERS, MAX_PLAYERS, NUM_PLAYERS);
+	printf("  --seed N    seed of the first game (default: current time)\n");
+	printf("  --strategy LIST  comma-separated strategy per seat, repeated if shorter than the table\n");
+	printf("              firstMatch (default), keepLongestSuit, dumpRarestRank, random or mcts\n");
+	printf("  --mcts-ms N        mcts thinking time per move in milliseconds (default %d, 0 for none,\n", MCTS_DEFAULT_TIME_MS);
+	printf("                     which needs --mcts-iterations)\n");
+	printf("  --mcts-iterations N  mcts playouts per thread and move (default: no limit)\n");
+	printf("  --mcts-threads N   mcts search threads (default: one per processor, 1 when --quiet\n");
+	printf("                     games run on several threads)\n");
+	printf("  --max-turns N    stop a game without a winner after N turns (default %d, 0 for no limit)\n", DEFAULT_MAX_TURNS);
+	printf("  --max-repeats N  stop a game that reshuffles back into the same position N times (default %d, at least 2, 0 to not check)\n", DEFAULT_MAX_REPEATS);
+	printf("  --threads N worker threads for --quiet runs (default: one per processor)\n");
+	printf("  --verbosity LEVEL  silent, summary, turns or full (default full)\n");
+	printf("  --quiet     only print the final summary line, and use all the threads\n");
+	printf("  --batch     with --quiet, play the games with the lockstep batch engine (firstMatch only)\n");
+	printf("  --stats     after the summary, print win rates with 95%% intervals and the mean, spread\n");
+	printf("              and percentiles of the turns, draws and reshuffles per game\n");
+	printf("  --lazy-deck keep the hidden deck as card counts and draw at random, so dealing and\n");
+	printf("              reshuffling cost the same for any pack count (games differ from the default)\n");
+	printf("  --lazy-shuffle  shuffle the hidden deck one card per draw, so the cards never drawn\n");
+	printf("              are never shuffled (games differ from the default)\n");
+	printf("  --record FILE  append a record of every game to FILE\n");
+	printf("  --replay FILE  replay every game recorded in FILE and check it\n");
+}
 
-	printf("Enter number of card packs to use: ");
-	scanf_s("%d", &numPacks);
+/**
+ * @brief Reads the numeric value that follows an option
+ *
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @param i Index of the option, advanced past the value
+ * @param value Where to store the parsed value
+ * @return 1 on success, 0 if the value is missing or not a number
+ */
+static int readOptionValue(int argc, char* argv[], int* i, unsigned long long* value)
+{
+	if (*i + 1 >= argc) {
+		return 0;
+	}
+
+	char* end;
+	*value = strtoull(argv[*i + 1], &end, 10);
+	if (end == argv[*i + 1] || *end != '\0') {
+		return 0;
+	}
+
+	(*i)++;
+	return 1;
+}
+
+/**
+ * @brief Reads a comma-separated list of strategy names
+ *
+ * @param list Names as given on the command line
+ * @param mcts Strategy to use for the name "mcts"
+ * @param strategies Where to store the strategies, MAX_PLAYERS entries
+ * @param count Where to store the number of names read
+ * @return 1 on success, 0 if a name is unknown or there are too many
+ */
+static int parseStrategies(const char* list, const Strategy* mcts, const Strategy* strategies[], int* count)
+{
+	char name[32];
+	*count = 0;
+
+	while (*list) {
+		size_t length = strcspn(list, ",");
+		if (length == 0 || length >= sizeof(name) || *count == MAX_PLAYERS) {
+			return 0;
+		}
+		memcpy(name, list, length);
+		name[length] = '\0';
+
+		strategies[*count] = strcmp(name, mcts -> name) == 0 ? mcts : findStrategy(name);
+		if (!strategies[*count]) {
+			return 0;
+		}
+		(*count)++;
+
+		list += length;
+		if (*list == ',') {
+			list++;
+		}
+	}
+	return *count > 0;
+}
+
+/**
+ * @brief Replays every record in a file
+ *
+ * @param path File written with --record
+ * @return Process exit code, 0 if every game replayed exactly
+ */
+static int replayFile(const char* path)
+{
+	FILE* in = fopen(path, "rb");
+	if (!in) {
+		fprintf(stderr, "Could not open %s\n", path);
+		return 1;
+	}
+
+	GameRecord record;
+	initGameRecord(&record);
+	long long replayed = 0;
+	long long failed = 0;
+	int status;
+
+	while ((status = readGameRecord(in, &record)) > 0) {
+		int move;
+		ReplayStatus result = replayGame(&record, &move);
+		replayed++;
+		if (result != REPLAY_OK) {
+			failed++;
+			fprintf(stderr, "game %lld (seed %llu): %s at move %d\n", replayed,
+				(unsigned long long)record.seed, replayStatusToString(result), move);
+		}
+	}
+
+	freeGameRecord(&record);
+	fclose(in);
+
+	if (status < 0) {
+		fprintf(stderr, "%s: invalid record after %lld game(s)\n", path, replayed);
+		return 1;
+	}
+	printf("replayed=%lld ok=%lld failed=%lld\n", replayed, replayed - failed, failed);
+	return failed > 0;
+}
+
+/**
+ * @brief Prints one per-game quantity: moments, 95% interval and percentiles
+ *
+ * @param name Quantity name
+ * @param stat Running moments
+ * @param histogram Distribution
+ */
+static void printQuantity(const char* name, const RunningStat* stat, const Histogram* histogram)
+{
+	printf("%s mean=%.3f sd=%.3f ci95=%.3f min=%.0f p50=%lld p90=%lld p99=%lld p999=%lld max=%.0f\n",
+		name, stat -> mean, runningStdDev(stat), runningConfidence(stat, CONFIDENCE_Z95), stat -> min,
+		histogramPercentile(histogram, 0.5), histogramPercentile(histogram, 0.9),
+		histogramPercentile(histogram, 0.99), histogramPercentile(histogram, 0.999), stat -> max);
+}
+
+/**
+ * @brief Prints the detailed statistics of a run (--stats)
+ *
+ * Win rates come with a 95% Wilson interval, the per-game quantities with
+ * the half width of a 95% interval for their mean. Percentiles are read
+ * from log histograms and are within 1/16 of the exact values.
+ *
+ * @param stats Totals of the run
+ * @param numPlayers Players per game
+ * @param numPacks Packs per game
+ */
+static void printStatsReport(const BatchStats* stats, int numPlayers, int numPacks)
+{
+	for (int p = 0; p < numPlayers; p++) {
+		double low, high;
+		proportionInterval(stats -> wins[p], stats -> games, CONFIDENCE_Z95, &low, &high);
+		printf("seat p%d win_rate=%.5f ci95=[%.5f,%.5f]\n", p + 1,
+			stats -> games ? (double)stats -> wins[p] / stats -> games : 0.0, low, high);
+	}
+	printQuantity("turns", &stats -> turnStats, &stats -> turnHistogram);
+	printQuantity("draws", &stats -> drawStats, &stats -> drawHistogram);
+	printQuantity("reshuffles", &stats -> reshuffleStats, &stats -> reshuffleHistogram);
+	printf("reshuffles_per_pack=%.5f packs=%d\n", stats -> reshuffleStats.mean / numPacks, numPacks);
+}
+
+int main(int argc, char* argv[])
+{
+	unsigned long long numGames = 1;
+	unsigned long long numPacks = 1;
+	unsigned long long numPlayers = NUM_PLAYERS;
+	unsigned long long seed = (unsigned long long)time(NULL);
+	unsigned long long numThreads = 0;
+	int quiet = 0;
+	int batch = 0;
+	int detailed = 0;
+	int lazyDeck = 0;
+	int lazyShuffle = 0;
+	const char* recordPath = NULL;
+	const Strategy* strategies[MAX_PLAYERS];
+	int numStrategies = 0;
+	MctsConfig mctsConfig;
+	initMctsConfig(&mctsConfig);
+	Strategy mcts = { "mcts", chooseMctsCard, &mctsConfig };
+	unsigned long long mctsValue = 0;
+	int mctsThreadsGiven = 0;
+	unsigned long long maxTurns = DEFAULT_MAX_TURNS;
+	unsigned long long maxRepeats = DEFAULT_MAX_REPEATS;
+	Verbosity verbosity = VERBOSITY_FULL;
 
-	if (numPacks <= 0) {
+	for (int i = 1; i < argc; i++) {
+		int ok = 1;
+
+		if (strcmp(argv[i], "--games") == 0) {
+			ok = readOptionValue(argc, argv, &i, &numGames);
+		} else if (strcmp(argv[i], "--packs") == 0) {
+			ok = readOptionValue(argc, argv, &i, &numPacks);
+		} else if (strcmp(argv[i], "--players") == 0) {
+			ok = readOptionValue(argc, argv, &i, &numPlayers) && numPlayers >= MIN_PLAYERS && numPlayers <= MAX_PLAYERS;
+		} else if (strcmp(argv[i], "--seed") == 0) {
+			ok = readOptionValue(argc, argv, &i, &seed);
+		} else if (strcmp(argv[i], "--strategy") == 0) {
+			ok = i + 1 < argc && parseStrategies(argv[++i], &mcts, strategies, &numStrategies);
+		} else if (strcmp(argv[i], "--mcts-ms") == 0) {
+			ok = readOptionValue(argc, argv, &i, &mctsValue) && mctsValue <= 3600000;
+			if (ok) {
+				mctsConfig.timeBudgetMs = (int)mctsValue;
+			}
+		} else if (strcmp(argv[i], "--mcts-iterations") == 0) {
+			ok = readOptionValue(argc, argv, &i, &mctsValue) && mctsValue <= 1000000000;
+			if (ok) {
+				mctsConfig.maxIterations = (int)mctsValue;
+			}
+		} else if (strcmp(argv[i], "--mcts-threads") == 0) {
+			ok = readOptionValue(argc, argv, &i, &mctsValue) && mctsValue <= MAX_THREADS;
+			if (ok) {
+				mctsConfig.numThreads = (int)mctsValue;
+				mctsThreadsGiven = 1;
+			}
+		} else if (strcmp(argv[i], "--max-turns") == 0) {
+			ok = readOptionValue(argc, argv, &i, &maxTurns) && maxTurns <= INT_MAX;
+		} else if (strcmp(argv[i], "--max-repeats") == 0) {
+			// the position being counted is in the history itself, so 1 would end every game at its first reshuffle
+			ok = readOptionValue(argc, argv, &i, &maxRepeats) && maxRepeats != 1 && maxRepeats <= CYCLE_HISTORY;
+		} else if (strcmp(argv[i], "--threads") == 0) {
+			ok = readOptionValue(argc, argv, &i, &numThreads) && numThreads <= MAX_THREADS;
+		} else if (strcmp(argv[i], "--verbosity") == 0) {
+			ok = i + 1 < argc && parseVerbosity(argv[++i], &verbosity);
+		} else if (strcmp(argv[i], "--quiet") == 0) {
+			quiet = 1;
+		} else if (strcmp(argv[i], "--batch") == 0) {
+			batch = 1;
+		} else if (strcmp(argv[i], "--stats") == 0) {
+			detailed = 1;
+		} else if (strcmp(argv[i], "--lazy-deck") == 0) {
+			lazyDeck = 1;
+		} else if (strcmp(argv[i], "--lazy-shuffle") == 0) {
+			lazyShuffle = 1;
+		} else if (strcmp(argv[i], "--record") == 0) {
+			ok = i + 1 < argc;
+			if (ok) {
+				recordPath = argv[++i];
+			}
+		} else if (strcmp(argv[i], "--replay") == 0) {
+			if (i + 1 >= argc) {
+				fprintf(stderr, "Invalid argument: %s\n", argv[i]);
+				return 1;
+			}
+			return replayFile(argv[i + 1]);
+		} else if (strcmp(argv[i], "--help") == 0) {
+			printUsage(argv[0]);
+			return 0;
+		} else {
+			ok = 0;
+		}
+
+		if (!ok) {
+			fprintf(stderr, "Invalid argument: %s\n", argv[i]);
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (numPacks == 0 || numPacks > 1000000) {
 		printf("Invalid number of packs. Using 1 pack by default.\n");
 		numPacks = 1;
 	}
 
-	simulateGame(numPacks);
+	// every player needs a full hand and one card has to be turned up
+	unsigned long long cardsNeeded = numPlayers * INITIAL_HAND_SIZE + 1;
+	if (numPacks * CARDS_PER_PACK < cardsNeeded) {
+		numPacks = (cardsNeeded + CARDS_PER_PACK - 1) / CARDS_PER_PACK;
+		printf("Not enough cards for %llu players. Using %llu packs.\n", numPlayers, numPacks);
+	}
+
+	// settings every game shares, each game only changes the seed
+	GameConfig base;
+	int firstMatchOnly = 1;
+	initGameConfig(&base, (int)numPacks, seed);
+	base.numPlayers = (int)numPlayers;
+	base.maxTurns = (int)maxTurns;
+	base.maxRepeats = (int)maxRepeats;
+	base.lazyHiddenDeck = lazyDeck;
+	base.lazyShuffle = lazyShuffle;
+	for (int p = 0; numStrategies > 0 && p < (int)numPlayers; p++) {
+		base.strategies[p] = strategies[p % numStrategies];
+		firstMatchOnly = firstMatchOnly && base.strategies[p] == &firstMatchStrategy;
+	}
+
+	if (batch && quiet && !firstMatchOnly) {
+		fprintf(stderr, "--batch only plays the firstMatch strategy\n");
+		return 1;
+	}
+	if ((lazyDeck || lazyShuffle) && ((batch && quiet) || recordPath)) {
+		// the batch engine has its own decks, and replays always use a shuffled deck
+		fprintf(stderr, "--lazy-deck and --lazy-shuffle cannot be combined with --batch or --record\n");
+		return 1;
+	}
+	if (mctsConfig.timeBudgetMs == 0 && mctsConfig.maxIterations == 0) {
+		// a search with neither limit would never end
+		fprintf(stderr, "--mcts-ms 0 needs --mcts-iterations\n");
+		return 1;
+	}
+	if (quiet && !mctsThreadsGiven && (numThreads > 0 ? (int)numThreads : defaultThreadCount()) > 1) {
+		// every game worker would start its own search threads, one per processor each, all
+		// racing the same time budget; the games already keep the processors busy
+		mctsConfig.numThreads = 1;
+	}
+
+	BatchStats stats;
+	FILE* recordFile = NULL;
+
+	if (recordPath) {
+		recordFile = fopen(recordPath, "ab");
+		if (!recordFile) {
+			fprintf(stderr, "Could not open %s\n", recordPath);
+			return 1;
+		}
+	}
+
+	if (recordFile && quiet) {
+		// every worker records into its own file, they are merged in seed order afterwards
+		int recorded = runGamesParallelRecorded(&base, (long long)numGames, (int)numThreads, recordFile, &stats);
+		fclose(recordFile);
+		if (!recorded) {
+			fprintf(stderr, "Could not start the worker threads or write to %s\n", recordPath);
+			return 1;
+		}
+	} else if (recordFile) {
+		// printed games run one after the other so their output stays readable
+		GameRecord record;
+		initGameRecord(&record);
+		initBatchStats(&stats);
+
+		for (unsigned long long g = 0; g < numGames; g++) {
+			GameConfig config = base;
+			GameResult result;
+			config.seed = seed + g;
+			config.record = &record;
+			if (verbosity > VERBOSITY_SILENT) {
+				config.sink = createTextSink(stdout, verbosity);
+			}
+
+			if (playGameWithConfig(&config, &result) && !writeGameRecord(recordFile, &record)) {
+				fprintf(stderr, "Could not write to %s\n", recordPath);
+				freeSink(config.sink);
+				break;
+			}
+			freeSink(config.sink);
+			addGameResult(&stats, &result);
+		}
+
+		freeGameRecord(&record);
+		fclose(recordFile);
+	} else if (quiet) {
+		// games are silent, so they can be spread over all the workers
+		int started = batch
+			? runGamesParallelBatchWithConfig(&base, (long long)numGames, (int)numThreads, NULL, &stats)
+			: runGamesParallelWithConfig(&base, (long long)numGames, (int)numThreads, NULL, &stats);
+		if (!started) {
+			fprintf(stderr, "Could not start the worker threads\n");
+			return 1;
+		}
+	} else {
+		// printed games run one after the other so their output stays readable
+		initBatchStats(&stats);
+		for (unsigned long long g = 0; g < numGames; g++) {
+			GameConfig config = base;
+			GameResult result;
+			config.seed = seed + g;
+			if (verbosity > VERBOSITY_SILENT) {
+				config.sink = createTextSink(stdout, verbosity);
+			}
+			playGameWithConfig(&config, &result);
+			freeSink(config.sink);
+			addGameResult(&stats, &result);
+		}
+	}
+
+	if (stats.failed > 0) {
+		fprintf(stderr, "%lld game(s) did not initialise\n", stats.failed);
+		return 1;
+	}
+
+	long long played = stats.games;
+	printf("games=%lld packs=%llu players=%llu seed=%llu", played, numPacks, numPlayers, seed);
+	for (int p = 0; p < (int)numPlayers; p++) {
+		printf(" wins_p%d=%lld", p + 1, stats.wins[p]);
+	}
+	printf(" avg_turns=%.3f avg_draws=%.3f avg_reshuffles=%.3f max_turns=%d",
+		played ? (double)stats.turns / played : 0.0,
+		played ? (double)stats.draws / played : 0.0,
+		played ? (double)stats.reshuffles / played : 0.0,
+		stats.maxTurns);
+	// games that were stopped without a winner are only listed when there are some
+	if (played > stats.outcomes[OUTCOME_WIN]) {
+		printf(" stalemates=%lld cycles=%lld turn_limits=%lld",
+			stats.outcomes[OUTCOME_STALEMATE], stats.outcomes[OUTCOME_CYCLE], stats.outcomes[OUTCOME_TURN_LIMIT]);
+		if (stats.outcomes[OUTCOME_ERROR] > 0) {
+			printf(" errors=%lld", stats.outcomes[OUTCOME_ERROR]);
+		}
+	}
+	printf("\n");
+	if (detailed) {
+		printStatsReport(&stats, (int)numPlayers, (int)numPacks);
+	}
+
+#if CARDGAME_COUNTERS
+	// built with the operation counters: every thread has flushed by now
+	OpCounters counters;
+	readTotalCounters(&counters);
+	printCounterReport(stdout, &counters, played);
+#endif
+#if CARDGAME_PROFILE
+	// built with the phase profiler: the flat profile goes last
+	ProfileData profile;
+	readTotalProfile(&profile);
+	printProfileReport(stdout, &profile, played);
+#endif
 
 	return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,648 @@
+/**
+ * @file mcts.c
+ * @brief Monte Carlo tree search player
+ *
+ * @author Oluwatunmise Adegbola
+ * @date 17 October 2026
+*/
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "mcts.h"
+#include "parallelSimulation.h"
+
+#define MCTS_DRAW NUM_CARD_TYPES	// action of a player without a match
+#define MAX_DEPTH 256	// deepest tree walk, the rest of the game is a random playout
+#define MAX_PLAYOUT_TURNS 2000	// playouts this long count as a shared result
+#define CLOCK_CHECK_INTERVAL 16	// playouts between two looks at the clock
+
+
+/**
+ * @brief Node of a search tree, the move that led to it and its results
+ */
+typedef struct MctsNode {
+	int firstChild;	// index of the first child, -1 if none
+	int nextSibling;	// index of the parent's next child, -1 if none
+	uint32_t visits;	// playouts through this node
+	uint32_t avail;	// playouts in which this node's move was legal
+	float wins;	// playouts won by the player who made the move
+	uint8_t action;	// card type played, or MCTS_DRAW
+	int8_t mover;	// player who made the move, -1 at the root
+} MctsNode;
+
+/**
+ * @brief A complete game in flat form, one determinization
+ */
+typedef struct Position {
+	uint64_t hands[MAX_PLAYERS];	// bit t set if card type t is held
+	uint32_t counts[MAX_PLAYERS][NUM_CARD_TYPES];	// copies held of each card type
+	int handSizes[MAX_PLAYERS];	// cards held
+	PackedCard* hidden;	// hidden deck, hidden[hiddenTop] is the top card
+	int hiddenTop;	// next card to draw
+	int hiddenEnd;	// one past the bottom card
+	PackedCard* played;	// played deck, bottom first
+	int playedSize;	// cards on the played deck
+	int current;	// card type to match
+	int player;	// player to move
+	int numPlayers;	// players at the table
+	int winner;	// winning player, -1 while the game goes on
+} Position;
+
+/**
+ * @brief What the searching player knows, shared read-only by the threads
+ */
+typedef struct RootInfo {
+	int numPlayers;	// players at the table
+	int me;	// searching player
+	int numCards;	// cards in the game
+	int current;	// card type to match
+	uint64_t myHand;	// card types held by the searching player
+	uint32_t myCounts[NUM_CARD_TYPES];	// copies of each held
+	int handSizes[MAX_PLAYERS];	// cards held by each player
+	PackedCard* played;	// played deck, bottom first
+	int playedSize;	// cards on the played deck
+	PackedCard* unknown;	// cards in other hands and the hidden deck
+	int numUnknown;	// number of unknown cards
+} RootInfo;
+
+/**
+ * @brief One search thread: its tree, its scratch game and its results
+ */
+typedef struct Searcher {
+	const RootInfo* root;	// position searched
+	const MctsConfig* config;	// search settings
+	uint64_t deadline;	// clock time to stop at, 0 for none
+	MctsNode* nodes;	// node arena, nodes[0] is the root
+	int numNodes;	// nodes in use
+	int maxNodes;	// size of the arena
+	PackedCard* cards;	// unknown cards of the determinization, then the hidden deck
+	PackedCard* played;	// played deck of the determinization
+	Position position;	// game being played out
+	Rng rng;	// random stream of this thread
+	long long iterations;	// playouts done
+	int failed;	// set if the arena could not be allocated
+} Searcher;
+
+
+/**
+ * @brief Index of the lowest set bit of a non-zero mask
+ */
+static inline int lowestBit(uint64_t mask)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, mask);
+	return (int)index;
+#else
+	return __builtin_ctzll(mask);
+#endif
+}
+
+
+/**
+ * @brief Number of set bits of a mask
+ */
+static inline int bitCount(uint64_t mask)
+{
+#ifdef _MSC_VER
+	return (int)__popcnt64(mask);
+#else
+	return __builtin_popcountll(mask);
+#endif
+}
+
+
+/**
+ * @brief Picks one set bit of a non-zero mask, each equally likely
+ */
+static inline int randomBit(uint64_t mask, Rng* rng)
+{
+	for (uint32_t skip = randomBelow(rng, (uint32_t)bitCount(mask)); skip > 0; skip--) {
+		mask &= mask - 1;
+	}
+	return lowestBit(mask);
+}
+
+
+/**
+ * @brief Monotonic clock in nanoseconds
+ */
+static uint64_t clockNs(void)
+{
+#ifdef _WIN32
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+	return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+#endif
+}
+
+
+/**
+ * @brief Adds a card to a hand of a position
+ */
+static inline void addToHand(Position* position, int player, int card)
+{
+	position -> counts[player][card]++;
+	position -> hands[player] |= 1ULL << card;
+	position -> handSizes[player]++;
+}
+
+
+/**
+ * @brief Same as reshuffleHiddenDeck(): all played cards but the top one
+ * become the hidden deck, shuffled
+ */
+static void reshuffle(Position* position, Rng* rng)
+{
+	int size = position -> playedSize;
+	if (size <= 1) {
+		return;
+	}
+
+	memcpy(position -> hidden, position -> played, (size_t)(size - 1));
+	position -> played[0] = position -> played[size - 1];
+	position -> playedSize = 1;
+	position -> hiddenTop = 0;
+	position -> hiddenEnd = size - 1;
+
+	for (int i = size - 2; i > 0; i--) {
+		int j = (int)randomBelow(rng, (uint32_t)i + 1);
+		PackedCard temp = position -> hidden[i];
+		position -> hidden[i] = position -> hidden[j];
+		position -> hidden[j] = temp;
+	}
+}
+
+
+/**
+ * @brief Moves the player to move can make, as a mask
+ *
+ * @return The matching card types held, or only the MCTS_DRAW bit
+ */
+static inline uint64_t legalActions(const Position* position)
+{
+	uint64_t playable = position -> hands[position -> player] & cardMatchMasks[position -> current];
+	return playable ? playable : 1ULL << MCTS_DRAW;
+}
+
+
+/**
+ * @brief Plays one move: a card, or a draw (which ends the turn)
+ */
+static void applyAction(Position* position, int action, Rng* rng)
+{
+	int player = position -> player;
+
+	if (action != MCTS_DRAW) {
+		if (--position -> counts[player][action] == 0) {
+			position -> hands[player] &= ~(1ULL << action);
+		}
+		position -> played[position -> playedSize++] = (PackedCard)action;
+		position -> current = action;
+		if (--position -> handSizes[player] == 0) {
+			position -> winner = player;
+			return;
+		}
+	} else {
+		if (position -> hiddenTop == position -> hiddenEnd) {
+			reshuffle(position, rng);
+		}
+		if (position -> hiddenTop < position -> hiddenEnd) {
+			addToHand(position, player, position -> hidden[position -> hiddenTop++]);
+		}
+	}
+
+	if (++position -> player == position -> numPlayers) {
+		position -> player = 0;
+	}
+}
+
+
+/**
+ * @brief Deals the cards the searcher cannot see at random
+ *
+ * The shuffled unknown cards fill the other hands first; what is left,
+ * in that order, is the hidden deck.
+ */
+static void determinize(Searcher* searcher)
+{
+	const RootInfo* root = searcher -> root;
+	Position* position = &searcher -> position;
+	PackedCard* cards = searcher -> cards;
+	int n = root -> numUnknown;
+
+	memcpy(cards, root -> unknown, (size_t)n);
+	for (int i = n - 1; i > 0; i--) {
+		int j = (int)randomBelow(&searcher -> rng, (uint32_t)i + 1);
+		PackedCard temp = cards[i];
+		cards[i] = cards[j];
+		cards[j] = temp;
+	}
+
+	int next = 0;
+	for (int p = 0; p < root -> numPlayers; p++) {
+		if (p == root -> me) {
+			memcpy(position -> counts[p], root -> myCounts, sizeof(root -> myCounts));
+			position -> hands[p] = root -> myHand;
+			position -> handSizes[p] = root -> handSizes[p];
+			continue;
+		}
+		memset(position -> counts[p], 0, sizeof(position -> counts[p]));
+		position -> hands[p] = 0;
+		position -> handSizes[p] = 0;
+		for (int i = 0; i < root -> handSizes[p]; i++) {
+			addToHand(position, p, cards[next++]);
+		}
+	}
+
+	position -> hidden = cards;
+	position -> hiddenTop = next;
+	position -> hiddenEnd = n;
+	memcpy(searcher -> played, root -> played, (size_t)root -> playedSize);
+	position -> played = searcher -> played;
+	position -> playedSize = root -> playedSize;
+	position -> current = root -> current;
+	position -> player = root -> me;
+	position -> numPlayers = root -> numPlayers;
+	position -> winner = -1;
+}
+
+
+/**
+ * @brief Finishes a game with random legal moves
+ *
+ * @param turns Turns already played in this playout
+ */
+static void playout(Position* position, Rng* rng, int turns)
+{
+	while (position -> winner < 0 && turns++ < MAX_PLAYOUT_TURNS) {
+		uint64_t actions = legalActions(position);
+		applyAction(position, randomBit(actions, rng), rng);
+	}
+}
+
+
+/**
+ * @brief Adds a child for a move below a node
+ *
+ * @return Index of the new node
+ */
+static int addChild(Searcher* searcher, int parent, int action, int mover)
+{
+	int index = searcher -> numNodes++;
+	MctsNode* node = &searcher -> nodes[index];
+	node -> firstChild = -1;
+	node -> nextSibling = searcher -> nodes[parent].firstChild;
+	node -> visits = 0;
+	node -> avail = 1;
+	node -> wins = 0.0f;
+	node -> action = (uint8_t)action;
+	node -> mover = (int8_t)mover;
+	searcher -> nodes[parent].firstChild = index;
+	return index;
+}
+
+
+/**
+ * @brief One playout: determinize, walk the tree, expand, play out, back up
+ */
+static void iterate(Searcher* searcher)
+{
+	Position* position = &searcher -> position;
+	double exploration = searcher -> config -> exploration;
+	int path[MAX_DEPTH + 1];
+	int depth = 0;
+	int node = 0;
+
+	determinize(searcher);
+	path[depth++] = node;
+
+	while (position -> winner < 0 && depth <= MAX_DEPTH) {
+		uint64_t untried = legalActions(position);
+		int best = -1;
+		double bestScore = -1.0;
+
+		// children legal in this determinization compete, the others sit out
+		for (int child = searcher -> nodes[node].firstChild; child >= 0; child = searcher -> nodes[child].nextSibling) {
+			MctsNode* c = &searcher -> nodes[child];
+			uint64_t bit = 1ULL << c -> action;
+			if (!(untried & bit)) {
+				continue;
+			}
+			untried &= ~bit;
+			c -> avail++;
+			double score = c -> wins / c -> visits + exploration * sqrt(log((double)c -> avail) / c -> visits);
+			if (score > bestScore) {
+				bestScore = score;
+				best = child;
+			}
+		}
+
+		if (untried) {
+			// a legal move without a node: add it (if there is room) and play out from there
+			int action = randomBit(untried, &searcher -> rng);
+			if (searcher -> numNodes < searcher -> maxNodes) {
+				path[depth++] = addChild(searcher, node, action, position -> player);
+			}
+			applyAction(position, action, &searcher -> rng);
+			break;
+		}
+
+		node = best;
+		path[depth++] = node;
+		applyAction(position, searcher -> nodes[node].action, &searcher -> rng);
+	}
+
+	playout(position, &searcher -> rng, depth);
+
+	// a win counts for the player who made the move, a cut-off game is shared
+	float shared = 1.0f / (float)position -> numPlayers;
+	for (int i = 1; i < depth; i++) {
+		MctsNode* n = &searcher -> nodes[path[i]];
+		n -> visits++;
+		n -> wins += position -> winner < 0 ? shared : (position -> winner == n -> mover ? 1.0f : 0.0f);
+	}
+	searcher -> nodes[0].visits++;
+	searcher -> iterations++;
+}
+
+
+/**
+ * @brief Runs one thread's search until its budget is spent
+ */
+static void runSearcher(Searcher* searcher)
+{
+	int numCards = searcher -> root -> numCards;
+	searcher -> nodes = malloc((size_t)searcher -> maxNodes * sizeof(MctsNode));
+	searcher -> cards = malloc((size_t)numCards);
+	searcher -> played = malloc((size_t)numCards);
+	if (!searcher -> nodes || !searcher -> cards || !searcher -> played) {
+		searcher -> failed = 1;
+		return;
+	}
+
+	searcher -> nodes[0].firstChild = -1;
+	searcher -> nodes[0].nextSibling = -1;
+	searcher -> nodes[0].visits = 0;
+	searcher -> nodes[0].avail = 0;
+	searcher -> nodes[0].wins = 0.0f;
+	searcher -> nodes[0].action = MCTS_DRAW;
+	searcher -> nodes[0].mover = -1;
+	searcher -> numNodes = 1;
+
+	int limit = searcher -> config -> maxIterations;
+	while (limit <= 0 || searcher -> iterations < limit) {
+		iterate(searcher);
+		if (searcher -> deadline && searcher -> iterations % CLOCK_CHECK_INTERVAL == 0
+			&& clockNs() >= searcher -> deadline) {
+			break;
+		}
+	}
+}
+
+#ifdef _WIN32
+static DWORD WINAPI searcherEntry(LPVOID arg)
+{
+	runSearcher((Searcher*)arg);
+	return 0;
+}
+#else
+static void* searcherEntry(void* arg)
+{
+	runSearcher((Searcher*)arg);
+	return NULL;
+}
+#endif
+
+
+/**
+ * @brief Collects what the player to move knows about the game
+ *
+ * @return true on success, false if the piles do not add up to whole packs
+ *         or memory ran out
+ */
+static bool buildRootInfo(const GameView* view, RootInfo* root)
+{
+	const HandIndex* hand = view -> hand;
+	uint32_t seen[NUM_CARD_TYPES];
+
+	memset(root, 0, sizeof(*root));
+	root -> numPlayers = view -> numPlayers;
+	root -> me = view -> player;
+	root -> current = packCard(view -> currentCard);
+	root -> numCards = view -> hiddenSize + view -> playedSize;
+	for (int p = 0; p < view -> numPlayers; p++) {
+		root -> handSizes[p] = view -> handSizes[p];
+		root -> numCards += root -> handSizes[p];
+	}
+	if (root -> numCards % CARDS_PER_PACK != 0) {
+		return false;
+	}
+
+	for (int s = 0; s < NUM_SUITS; s++) {
+		for (int r = 0; r < NUM_RANKS; r++) {
+			int t = s * NUM_RANKS + r;
+			root -> myCounts[t] = (uint32_t)hand -> counts[s][r];
+			if (hand -> counts[s][r] > 0) {
+				root -> myHand |= 1ULL << t;
+			}
+		}
+	}
+
+	// the played deck is face up, its cards are known
+	root -> played = malloc((size_t)root -> numCards);
+	root -> unknown = malloc((size_t)root -> numCards);
+	if (!root -> played || !root -> unknown) {
+		return false;
+	}
+	root -> playedSize = packDeck(view -> playedDeck, root -> unknown);
+	memcpy(seen, root -> myCounts, sizeof(seen));
+	for (int i = 0; i < root -> playedSize; i++) {
+		root -> played[i] = root -> unknown[root -> playedSize - 1 - i];
+		seen[root -> played[i]]++;
+	}
+
+	// every copy not seen is in another hand or in the hidden deck
+	uint32_t numPacks = (uint32_t)(root -> numCards / CARDS_PER_PACK);
+	for (int t = 0; t < NUM_CARD_TYPES; t++) {
+		for (uint32_t n = seen[t]; n < numPacks; n++) {
+			root -> unknown[root -> numUnknown++] = (PackedCard)t;
+		}
+	}
+	return root -> numUnknown == root -> numCards - root -> playedSize - root -> handSizes[view -> player];
+}
+
+
+/**
+ * @brief Fills a configuration with the default settings
+ */
+void initMctsConfig(MctsConfig* config)
+{
+	config -> timeBudgetMs = MCTS_DEFAULT_TIME_MS;
+	config -> maxIterations = 0;
+	config -> numThreads = 0;
+	config -> exploration = MCTS_DEFAULT_EXPLORATION;
+	config -> maxNodes = MCTS_DEFAULT_NODES;
+}
+
+
+/**
+ * @brief Searches for the best card for a player to play
+ */
+int mctsSearch(const GameView* view, const MctsConfig* config, uint64_t seed, MctsStats* stats)
+{
+	uint64_t start = clockNs();
+	const Card* current = &view -> currentCard;
+	uint64_t legal = 0;
+	int choice = -1;
+
+	if (stats) {
+		memset(stats, 0, sizeof(*stats));
+	}
+
+	Card firstCard;
+	if (handFirstMatch(view -> hand, current, &firstCard) < 0) {
+		return -1;
+	}
+	choice = packCard(firstCard);
+
+	RootInfo root;
+	if (!buildRootInfo(view, &root)) {
+		free(root.played);
+		free(root.unknown);
+		return choice;	// fall back to the first match
+	}
+	legal = root.myHand & cardMatchMasks[root.current];
+	if (bitCount(legal) == 1) {
+		free(root.played);
+		free(root.unknown);
+		return choice;	// nothing to think about
+	}
+
+	int numThreads = config -> numThreads > 0 ? config -> numThreads : defaultThreadCount();
+	if (numThreads > MAX_THREADS) {
+		numThreads = MAX_THREADS;
+	}
+	int budgetMs = config -> timeBudgetMs;
+	if (budgetMs <= 0 && config -> maxIterations <= 0) {
+		budgetMs = MCTS_DEFAULT_TIME_MS;
+	}
+
+	Searcher* searchers = calloc((size_t)numThreads, sizeof(Searcher));
+	if (!searchers) {
+		free(root.played);
+		free(root.unknown);
+		return choice;
+	}
+	for (int t = 0; t < numThreads; t++) {
+		searchers[t].root = &root;
+		searchers[t].config = config;
+		searchers[t].deadline = budgetMs > 0 ? start + (uint64_t)budgetMs * 1000000ULL : 0;
+		searchers[t].maxNodes = config -> maxNodes > 1 ? config -> maxNodes : MCTS_DEFAULT_NODES;
+		seedRng(&searchers[t].rng, seed + (uint64_t)t);
+	}
+
+#ifdef _WIN32
+	HANDLE threads[MAX_THREADS];
+#else
+	pthread_t threads[MAX_THREADS];
+#endif
+
+	// the calling thread is searcher 0
+	int started = 1;
+	for (int t = 1; t < numThreads; t++) {
+#ifdef _WIN32
+		threads[t] = CreateThread(NULL, 0, searcherEntry, &searchers[t], 0, NULL);
+		if (threads[t] == NULL) {
+			break;
+		}
+#else
+		if (pthread_create(&threads[t], NULL, searcherEntry, &searchers[t]) != 0) {
+			break;
+		}
+#endif
+		started++;
+	}
+	runSearcher(&searchers[0]);
+	for (int t = 1; t < started; t++) {
+#ifdef _WIN32
+		WaitForSingleObject(threads[t], INFINITE);
+		CloseHandle(threads[t]);
+#else
+		pthread_join(threads[t], NULL);
+#endif
+	}
+
+	// sum the root moves over the trees, most visits wins, ties to the lower card
+	uint64_t visits[NUM_CARD_TYPES] = { 0 };
+	for (int t = 0; t < started; t++) {
+		Searcher* searcher = &searchers[t];
+		if (!searcher -> failed) {
+			for (int child = searcher -> nodes[0].firstChild; child >= 0; child = searcher -> nodes[child].nextSibling) {
+				visits[searcher -> nodes[child].action] += searcher -> nodes[child].visits;
+			}
+		}
+		if (stats) {
+			stats -> iterations += searcher -> iterations;
+			stats -> nodes += searcher -> numNodes;
+		}
+		free(searcher -> nodes);
+		free(searcher -> cards);
+		free(searcher -> played);
+	}
+	for (uint64_t m = legal; m != 0; m &= m - 1) {
+		int t = lowestBit(m);
+		if (visits[t] > visits[choice]) {
+			choice = t;
+		}
+	}
+
+	if (stats) {
+		stats -> threads = started;
+		stats -> elapsedMs = (double)(clockNs() - start) / 1e6;
+	}
+
+	free(searchers);
+	free(root.played);
+	free(root.unknown);
+	return choice;
+}
+
+
+/**
+ * @brief ChooseCardFn running mctsSearch()
+ */
+int chooseMctsCard(const GameView* view, void* context)
+{
+	MctsConfig defaults;
+	const MctsConfig* config = context;
+	if (!config) {
+		initMctsConfig(&defaults);
+		config = &defaults;
+	}
+
+	int card = mctsSearch(view, config, nextRandom(view -> rng), NULL);
+	if (card < 0) {
+		return STRATEGY_DRAW;
+	}
+	return handPositionOf(view -> hand, unpackCard((PackedCard)card));
+}
@@ -0,0 +1,100 @@
+/**
+ * @file mcts.h
+ * @brief Monte Carlo tree search player (information set MCTS)
+ *
+ * The player to move cannot see the other hands or the order of the
+ * hidden deck, so every playout starts from a determinization: the cards
+ * it cannot see (everything not in its own hand or on the played deck)
+ * are shuffled and dealt to the other players, by their hand sizes, and
+ * to the hidden deck. The playout then walks one shared tree, choosing
+ * among the moves that are legal in that determinization with UCB over
+ * how often each move was available (SO-ISMCTS), adds one node and
+ * finishes the game with random legal moves under the normal rules: a
+ * player holding a match must play, a player without one draws, and an
+ * empty hidden deck is refilled from the played deck.
+ *
+ * Playouts run on flat arrays of PackedCards and 52-bit hand masks, not
+ * on GameState, and tree nodes come from one array per thread, so a
+ * playout allocates nothing. Each thread grows its own tree from the same
+ * position (root parallelisation) until the time budget or iteration
+ * limit runs out; the visit counts of the root moves are then summed and
+ * the most visited move is played.
+ *
+ * @author Oluwatunmise Adegbola
+ * @date 17 October 2026
+*/
+
+#ifndef MCTS_H
+#define MCTS_H
+
+#include <stdint.h>
+
+#include "game.h"
+#include "strategy.h"
+
+#define MCTS_DEFAULT_TIME_MS 50
+#define MCTS_DEFAULT_NODES (1 << 16)
+#define MCTS_DEFAULT_EXPLORATION 0.7
+
+/**
+  * @brief Search settings
+*/
+typedef struct MctsConfig {
+	int timeBudgetMs;	// wall time per move in milliseconds, 0 for no limit (MCTS_DEFAULT_TIME_MS if maxIterations is 0 too)
+	int maxIterations;	// playouts per thread, 0 for no limit
+	int numThreads;	// search threads, 0 for one per processor
+	double exploration;	// UCB exploration constant
+	int maxNodes;	// tree nodes per thread; when full, playouts stop adding nodes
+} MctsConfig;
+
+/**
+  * @brief What one search did
+*/
+typedef struct MctsStats {
+	long long iterations;	// playouts over all threads
+	long long nodes;	// tree nodes over all threads
+	int threads;	// threads that searched
+	double elapsedMs;	// wall time of the search
+} MctsStats;
+
+/**
+  * @brief Fills a configuration with the default settings
+  *
+  * MCTS_DEFAULT_TIME_MS per move, no iteration limit, one thread per
+  * processor.
+  *
+  * @param config Configuration to fill, cannot be NULL
+*/
+void initMctsConfig(MctsConfig* config);
+
+/**
+  * @brief Searches for the best card for a player to play
+  *
+  * Only what the player can see is used: their own hand, the played
+  * deck and the size of every other pile. With no time budget and an
+  * iteration limit the result depends only on the seed and the thread
+  * count. If timeBudgetMs and maxIterations are both 0 the default time
+  * budget is used.
+  *
+  * @param view Position of the player to move, see initGameView()
+  * @param config Search settings, cannot be NULL
+  * @param seed Seed of the search's random streams
+  * @param stats Where to store what the search did, may be NULL
+  * @return Packed card to play, or -1 if the player has no matching card
+*/
+int mctsSearch(const GameView* view, const MctsConfig* config, uint64_t seed, MctsStats* stats);
+
+/**
+  * @brief ChooseCardFn running mctsSearch()
+  *
+  * Use it as { "mcts", chooseMctsCard, &config }; a NULL context uses
+  * the default settings. The search is seeded from the view's random
+  * stream.
+  *
+  * @param view Position of the player to move
+  * @param context MctsConfig to search with, or NULL
+  * @return Position of the card to play in the sorted hand
+*/
+int chooseMctsCard(const GameView* view, void* context);
+
+#endif // !MCTS_H
@@ -0,0 +1,208 @@
+/**
+ * @file nodePool.c
+ * @brief Implementation of the CardNode slab allocator
+ *
+ * Slabs are only ever added, never returned to the heap before
+ * freeNodePool(), so a pool's size is the peak number of nodes in use.
+ *
+ * @author Shrestha Dey
+ * @date 17 October 2026
+ */
+#include "counters.h"
+#include "nodePool.h"
+#include <limits.h>
+#include <stdlib.h>
+
+#define DEFAULT_SLAB_NODES 256
+
+/**
+ * @brief Helper function to add one slab to the free list
+ *
+ * @param pool Pool to grow
+ * @return true on success, false on memory allocation failure
+ */
+static bool addSlab(NodePool* pool)
+{
+    COUNT_OP(COUNTER_SLAB_MALLOCS);
+    NodeSlab* slab = malloc(sizeof(NodeSlab) + (size_t)pool->slab_nodes * sizeof(CardNode));
+    if (!slab) {
+        return false;
+    }
+
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+
+    /// Thread the new nodes onto the free list
+    for (int i = 0; i < pool->slab_nodes; i++) {
+        slab->nodes[i].next = pool->free_list;
+        pool->free_list = &slab->nodes[i];
+    }
+    pool->total_nodes += pool->slab_nodes;
+    return true;
+}
+
+/**
+ * @brief Creates an empty node pool
+ */
+NodePool* createNodePool(int slab_nodes)
+{
+    NodePool* pool = malloc(sizeof(NodePool));
+    if (!pool) {
+        return NULL;
+    }
+
+    pool->free_list = NULL;
+    pool->slabs = NULL;
+    pool->slab_nodes = slab_nodes > 0 ? slab_nodes : DEFAULT_SLAB_NODES;
+    pool->total_nodes = 0;
+    pool->scratch = NULL;
+    pool->scratch_capacity = 0;
+    pool->spare_count = 0;
+    return pool;
+}
+
+/**
+ * @brief Frees a pool and every node it ever handed out
+ */
+void freeNodePool(NodePool* pool)
+{
+    if (!pool) {
+        return;
+    }
+
+    NodeSlab* slab = pool->slabs;
+    while (slab) {
+        NodeSlab* next = slab->next;
+        free(slab);
+        slab = next;
+    }
+
+    for (int i = 0; i < pool->spare_count; i++) {
+        free(pool->spare_blocks[i]);
+    }
+    free(pool->scratch);
+    free(pool);
+}
+
+/**
+ * @brief Makes sure at least count nodes can be handed out without malloc
+ */
+bool reserveNodes(NodePool* pool, int count)
+{
+    int available = 0;
+    for (CardNode* node = pool->free_list; node && available < count; node = node->next) {
+        available++;
+    }
+
+    while (available < count) {
+        if (!addSlab(pool)) {
+            return false;
+        }
+        available += pool->slab_nodes;
+    }
+    return true;
+}
+
+/**
+ * @brief Takes one node from the pool
+ */
+CardNode* poolAllocNode(NodePool* pool)
+{
+    if (!pool->free_list && !addSlab(pool)) {
+        return NULL;
+    }
+
+    COUNT_OP(COUNTER_POOL_NODES);
+    CardNode* node = pool->free_list;
+    pool->free_list = node->next;
+    return node;
+}
+
+/**
+ * @brief Gives one node back to the pool
+ */
+void poolFreeNode(NodePool* pool, CardNode* node)
+{
+    node->next = pool->free_list;
+    pool->free_list = node;
+}
+
+/**
+ * @brief Gives a whole chain of nodes back to the pool in O(1)
+ */
+void poolFreeChain(NodePool* pool, CardNode* first, CardNode* last)
+{
+    if (!first) {
+        return;
+    }
+
+    last->next = pool->free_list;
+    pool->free_list = first;
+}
+
+/**
+ * @brief Returns a work buffer of at least count cards owned by the pool
+ */
+Card* poolScratch(NodePool* pool, int count)
+{
+    if (count > pool->scratch_capacity) {
+        int capacity = pool->scratch_capacity ? pool->scratch_capacity : CARDS_PER_PACK;
+        while (capacity < count) {
+            capacity = capacity > INT_MAX / 2 ? count : capacity * 2;
+        }
+
+        Card* scratch = realloc(pool->scratch, (size_t)capacity * sizeof(Card));
+        if (!scratch) {
+            return NULL;
+        }
+        pool->scratch = scratch;
+        pool->scratch_capacity = capacity;
+    }
+    return pool->scratch;
+}
+
+/**
+ * @brief Takes a block of memory, a spare one of the same size if the
+ * pool has one
+ *
+ * The newest spare blocks are searched first, a game frees and takes its
+ * blocks in about the same order.
+ */
+void* poolAllocBlock(NodePool* pool, size_t size)
+{
+    if (!pool) {
+        return malloc(size);
+    }
+
+    for (int i = pool->spare_count - 1; i >= 0; i--) {
+        if (pool->spare_sizes[i] == size) {
+            void* block = pool->spare_blocks[i];
+            pool->spare_count--;
+            pool->spare_blocks[i] = pool->spare_blocks[pool->spare_count];
+            pool->spare_sizes[i] = pool->spare_sizes[pool->spare_count];
+            return block;
+        }
+    }
+
+    COUNT_OP(COUNTER_BLOCK_MALLOCS);
+    return malloc(size);
+}
+
+/**
+ * @brief Gives a block back, the pool keeps it for the next request of
+ * the same size
+ */
+void poolFreeBlock(NodePool* pool, void* block, size_t size)
+{
+    if (!block) {
+        return;
+    }
+    if (!pool || pool->spare_count == POOL_SPARE_BLOCKS) {
+        free(block);
+        return;
+    }
+
+    pool->spare_blocks[pool->spare_count] = block;
+    pool->spare_sizes[pool->spare_count] = size;
+    pool->spare_count++;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file nodePool.h
+ * @brief NodePool type: slab allocator for linked list CardNodes
+ *
+ * A pool hands out CardNodes from large slabs and keeps released nodes on
+ * a free list, so moving a card between decks costs a couple of pointer
+ * writes instead of a malloc/free round trip. All decks of one game (or
+ * all games run by one thread) share a pool.
+ *
+ * The pool also keeps the other blocks a game frees, the GameState, its
+ * players, the deck headers and the card arrays of ring buffer decks, and
+ * hands them out again by size (poolAllocBlock()). Once the pool has grown
+ * to the largest game played on it, creating and freeing a game makes no
+ * heap calls at all.
+ *
+ * A pool is not thread safe: use one pool per thread.
+ *
+ * @author Shrestha Dey
+ * @date 17 October 2026
+ */
+
+#pragma once
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include "deck.h"
+#include <stddef.h>
+
+#define POOL_SPARE_BLOCKS 64  ///< Freed blocks a pool keeps, enough for a full table of ring buffer decks
+
+/**
+ * @brief One slab of nodes, slabs are chained so they can be freed
+ */
+typedef struct NodeSlab {
+    struct NodeSlab* next;  ///< Previously allocated slab, or NULL
+    CardNode nodes[];       ///< Nodes handed out by the pool
+} NodeSlab;
+
+/**
+ * @brief Structure representing a node pool
+ */
+struct NodePool {
+    CardNode* free_list;    ///< Released nodes, linked through next
+    NodeSlab* slabs;        ///< All slabs, newest first
+    int slab_nodes;         ///< Number of nodes in each new slab
+    int total_nodes;        ///< Nodes owned by the pool (in use or free)
+    Card* scratch;          ///< Work buffer reused by shuffleDeck()
+    int scratch_capacity;   ///< Number of cards scratch can hold
+    void* spare_blocks[POOL_SPARE_BLOCKS];  ///< Freed blocks kept for poolAllocBlock()
+    size_t spare_sizes[POOL_SPARE_BLOCKS];  ///< Size of each spare block in bytes
+    int spare_count;        ///< Number of spare blocks
+};
+
+/**
+ * @brief Creates an empty node pool
+ *
+ * @param slab_nodes Number of nodes allocated at a time (<= 0 for a default)
+ * @return Pointer to the new pool, or NULL on allocation failure
+ */
+NodePool* createNodePool(int slab_nodes);
+
+/**
+ * @brief Frees a pool and every node it ever handed out
+ *
+ * All decks using the pool must have been freed first.
+ *
+ * @param pool Pool to free, can be NULL
+ */
+void freeNodePool(NodePool* pool);
+
+/**
+ * @brief Makes sure at least count nodes can be handed out without malloc
+ *
+ * Useful to do the warm-up before a timed or multithreaded run.
+ *
+ * @param pool Pool to grow, cannot be NULL
+ * @param count Number of free nodes wanted
+ * @return true on success, false on memory allocation failure
+ */
+bool reserveNodes(NodePool* pool, int count);
+
+/**
+ * @brief Takes one node from the pool
+ *
+ * @param pool Pool to allocate from, cannot be NULL
+ * @return Uninitialised node, or NULL on memory allocation failure
+ */
+CardNode* poolAllocNode(NodePool* pool);
+
+/**
+ * @brief Gives one node back to the pool
+ *
+ * @param pool Pool the node came from, cannot be NULL
+ * @param node Node to release, cannot be NULL
+ */
+void poolFreeNode(NodePool* pool, CardNode* node);
+
+/**
+ * @brief Gives a whole chain of nodes back to the pool in O(1)
+ *
+ * @param pool Pool the nodes came from, cannot be NULL
+ * @param first First node of the chain, can be NULL for an empty chain
+ * @param last Last node of the chain (reachable from first)
+ */
+void poolFreeChain(NodePool* pool, CardNode* first, CardNode* last);
+
+/**
+ * @brief Returns a work buffer of at least count cards owned by the pool
+ *
+ * The buffer is only valid until the next call.
+ *
+ * @param pool Pool owning the buffer, cannot be NULL
+ * @param count Number of cards needed
+ * @return Pointer to the buffer, or NULL on memory allocation failure
+ */
+Card* poolScratch(NodePool* pool, int count);
+
+/**
+ * @brief Takes a block of memory, a spare one of the same size if the
+ * pool has one
+ *
+ * Like malloc(), the contents are undefined.
+ *
+ * @param pool Pool to take the block from, NULL to use malloc()
+ * @param size Size of the block in bytes
+ * @return Pointer to the block, or NULL on memory allocation failure
+ */
+void* poolAllocBlock(NodePool* pool, size_t size);
+
+/**
+ * @brief Gives a block back, the pool keeps it for the next request of
+ * the same size
+ *
+ * The block is freed instead when the pool already keeps
+ * POOL_SPARE_BLOCKS blocks.
+ *
+ * @param pool Pool the block came from, NULL if it came from malloc()
+ * @param block Block to release, can be NULL
+ * @param size Size the block was taken with
+ */
+void poolFreeBlock(NodePool* pool, void* block, size_t size);
+
+#endif
@@ -0,0 +1,380 @@
+/**
+ * @file parallelSimulation.c
+ * @brief Runs batches of games on several threads
+ *
+ * Uses Win32 threads on Windows and POSIX threads everywhere else. Each
+ * worker keeps its own BatchStats, and the totals are merged once all
+ * workers have finished, so the workers never share writable state.
+ *
+ * @author Oluwatunmise Adegbola
+ * @date 17 October 2026
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#include "batchSimulation.h"
+#include "counters.h"
+#include "gameRecord.h"
+#include "nodePool.h"
+#include "parallelSimulation.h"
+#include "profiler.h"
+
+#define GAMES_PER_CHUNK 256
+
+
+/**
+ * @brief Work description and private totals of one worker thread
+ */
+typedef struct Worker {
+	int index;	// worker number, 0 to numThreads-1
+	int numThreads;	// total number of workers
+	const GameConfig* config;	// settings shared by every game, seed is that of game 0
+	long long numGames;	// games in the whole batch
+	GameResult* results;	// shared results array (disjoint slots), may be NULL
+	int lockstep;	// play through the lockstep batch engine
+	FILE* records;	// temporary file the worker's game records go to, or NULL
+	int recordFailed;	// set if a record could not be written
+	BatchStats stats;	// totals of the games played by this worker
+} Worker;
+
+
+/**
+ * @brief Plays one worker's share of the batch with the lockstep engine
+ *
+ * The engine keeps its slots busy best with one long run, so each worker
+ * takes a contiguous range of games instead of striped chunks. Totals are
+ * exact sums, so the split does not change them.
+ *
+ * @param worker Work description, its stats are filled in
+ */
+static void runLockstepWorker(Worker* worker)
+{
+	long long share = worker -> numGames / worker -> numThreads;
+	long long extra = worker -> numGames % worker -> numThreads;
+	long long first = share * worker -> index + (worker -> index < extra ? worker -> index : extra);
+	long long count = share + (worker -> index < extra ? 1 : 0);
+
+	BatchEngine* engine = createBatchEngine(worker -> config -> numPacks, worker -> config -> numPlayers, 0);
+	if (!engine) {
+		worker -> stats.failed += count;
+		return;
+	}
+	setBatchLimits(engine, worker -> config -> maxTurns, worker -> config -> maxRepeats);
+
+	runBatchGames(engine, worker -> config -> seed, first, count,
+		worker -> results ? worker -> results + first : NULL, &worker -> stats);
+	freeBatchEngine(engine);
+}
+
+
+/**
+ * @brief Plays every chunk assigned to one worker
+ *
+ * Chunk c goes to worker c % numThreads, so the split is fixed up front
+ * and needs no locking. All games of a worker share one NodePool, so
+ * after the first game cards move between decks without heap calls.
+ * Sinks are not thread-safe and are left out; when recording, each game's
+ * record is appended to the worker's own file, in the order it was played.
+ *
+ * @param worker Work description, its stats are filled in
+ */
+static void runWorker(Worker* worker)
+{
+	if (worker -> lockstep) {
+		runLockstepWorker(worker);
+		return;
+	}
+
+	long long numChunks = (worker -> numGames + GAMES_PER_CHUNK - 1) / GAMES_PER_CHUNK;
+	GameConfig config = *worker -> config;
+	config.sink = NULL;
+	config.pool = createNodePool(0);
+	GameRecord record;
+	initGameRecord(&record);
+	config.record = worker -> records ? &record : NULL;
+
+	for (long long chunk = worker -> index; chunk < numChunks; chunk += worker -> numThreads) {
+		long long first = chunk * GAMES_PER_CHUNK;
+		long long last = first + GAMES_PER_CHUNK;
+		if (last > worker -> numGames) {
+			last = worker -> numGames;
+		}
+
+		for (long long g = first; g < last; g++) {
+			GameResult result;
+			config.seed = worker -> config -> seed + (unsigned long long)g;
+			if (playGameWithConfig(&config, &result) && config.record
+				&& !writeGameRecord(worker -> records, config.record)) {
+				// the run fails anyway, stop recording
+				worker -> recordFailed = 1;
+				config.record = NULL;
+			}
+			addGameResult(&worker -> stats, &result);
+			if (worker -> results) {
+				worker -> results[g] = result;
+			}
+		}
+	}
+
+	freeGameRecord(&record);
+	freeNodePool(config.pool);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI workerEntry(LPVOID arg)
+{
+	runWorker((Worker*)arg);
+	flushThreadCounters();	// the thread's counts die with it
+	flushThreadProfile();
+	return 0;
+}
+#else
+static void* workerEntry(void* arg)
+{
+	runWorker((Worker*)arg);
+	flushThreadCounters();	// the thread's counts die with it
+	flushThreadProfile();
+	return NULL;
+}
+#endif
+
+
+/**
+ * @brief Returns the number of processors available to the program
+ *
+ * @return Number of online processors, at least 1
+ */
+int defaultThreadCount(void)
+{
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	int count = (int)info.dwNumberOfProcessors;
+#else
+	int count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	if (count < 1) {
+		count = 1;
+	}
+	if (count > MAX_THREADS) {
+		count = MAX_THREADS;
+	}
+	return count;
+}
+
+
+/**
+ * @brief Copies the records of all workers into one stream, in game order
+ *
+ * Game g was played by the worker owning its chunk, which wrote its
+ * records in the order it played them. A game that did not initialise
+ * left no record, so a worker's next record is only copied when its seed
+ * is that of the game.
+ *
+ * @param workers Workers, their record files are read from the start
+ * @param numThreads Number of workers
+ * @param config Settings of every game, seed is that of the first game
+ * @param numGames Number of games in the batch
+ * @param out Stream to append the records to
+ * @return 1 on success, 0 on a read, write or memory allocation failure
+ */
+static int mergeRecords(Worker* workers, int numThreads, const GameConfig* config, long long numGames, FILE* out)
+{
+	GameRecord* next = calloc((size_t)numThreads, sizeof(GameRecord));
+	int* held = calloc((size_t)numThreads, sizeof(int));
+	int ok = next && held;
+
+	for (int t = 0; ok && t < numThreads; t++) {
+		initGameRecord(&next[t]);
+		rewind(workers[t].records);
+	}
+
+	for (long long g = 0; ok && g < numGames; g++) {
+		int t = (int)((g / GAMES_PER_CHUNK) % numThreads);
+		if (!held[t]) {
+			held[t] = readGameRecord(workers[t].records, &next[t]);	// 0 once the worker's records run out
+			ok = held[t] >= 0;
+		}
+		if (ok && held[t] && next[t].seed == config -> seed + (unsigned long long)g) {
+			ok = writeGameRecord(out, &next[t]);
+			held[t] = 0;
+		}
+	}
+
+	for (int t = 0; next && t < numThreads; t++) {
+		freeGameRecord(&next[t]);
+	}
+	free(next);
+	free(held);
+	return ok;
+}
+
+
+/**
+ * @brief Runs a batch on several threads with either engine
+ *
+ * Worker 0 runs on the calling thread; the others are started here and
+ * joined before the totals are merged in worker order. When recording,
+ * each worker writes to a temporary file of its own and the files are
+ * merged into recordFile after the join.
+ *
+ * @param config Settings of every game, seed is that of the first game
+ * @param numGames Number of games to play
+ * @param numThreads Number of worker threads, 0 for one per processor
+ * @param results Array of numGames results to fill, or NULL
+ * @param stats Where to store the merged totals
+ * @param lockstep Play through the lockstep batch engine, which does not record
+ * @param recordFile Stream to append the records to, or NULL
+ * @return 1 on success, 0 if the worker threads could not be started or
+ *         the records could not be written
+ */
+static int runParallel(const GameConfig* config, long long numGames,
+	int numThreads, GameResult* results, BatchStats* stats, int lockstep, FILE* recordFile)
+{
+	initBatchStats(stats);
+
+	if (numThreads <= 0) {
+		numThreads = defaultThreadCount();
+	}
+	if (numThreads > MAX_THREADS) {
+		numThreads = MAX_THREADS;
+	}
+
+	Worker* workers = calloc((size_t)numThreads, sizeof(Worker));
+	if (!workers) {
+		return 0;
+	}
+
+#ifdef _WIN32
+	HANDLE threads[MAX_THREADS];
+#else
+	pthread_t threads[MAX_THREADS];
+#endif
+
+	int started = 1;
+	int ok = 1;
+	for (int t = 0; t < numThreads; t++) {
+		workers[t].index = t;
+		workers[t].numThreads = numThreads;
+		workers[t].config = config;
+		workers[t].numGames = numGames;
+		workers[t].results = results;
+		workers[t].lockstep = lockstep;
+		workers[t].records = NULL;
+		workers[t].recordFailed = 0;
+		initBatchStats(&workers[t].stats);
+		if (recordFile && !lockstep && ok) {
+			workers[t].records = tmpfile();
+			ok = workers[t].records != NULL;
+		}
+	}
+
+	// start the helpers, worker 0 is the calling thread
+	for (int t = 1; t < numThreads && ok; t++) {
+#ifdef _WIN32
+		threads[t] = CreateThread(NULL, 0, workerEntry, &workers[t], 0, NULL);
+		ok = threads[t] != NULL;
+#else
+		ok = pthread_create(&threads[t], NULL, workerEntry, &workers[t]) == 0;
+#endif
+		if (ok) {
+			started++;
+		}
+	}
+
+	if (ok) {
+		runWorker(&workers[0]);
+	}
+
+	for (int t = 1; t < started; t++) {
+#ifdef _WIN32
+		WaitForSingleObject(threads[t], INFINITE);
+		CloseHandle(threads[t]);
+#else
+		pthread_join(threads[t], NULL);
+#endif
+	}
+
+	// merge in worker order
+	if (ok) {
+		for (int t = 0; t < numThreads; t++) {
+			mergeBatchStats(stats, &workers[t].stats);
+			ok = ok && !workers[t].recordFailed;
+		}
+	}
+	if (ok && recordFile && !lockstep) {
+		ok = mergeRecords(workers, numThreads, config, numGames, recordFile);
+	}
+
+	for (int t = 0; t < numThreads; t++) {
+		if (workers[t].records) {
+			fclose(workers[t].records);
+		}
+	}
+	free(workers);
+	return ok;
+}
+
+
+/**
+ * @brief Plays a batch of games silently on several threads
+ */
+int runGamesParallel(int numPacks, int numPlayers, unsigned long long seed, long long numGames,
+	int numThreads, GameResult* results, BatchStats* stats)
+{
+	GameConfig config;
+	initGameConfig(&config, numPacks, (uint64_t)seed);
+	config.numPlayers = numPlayers;
+	return runParallel(&config, numGames, numThreads, results, stats, 0, NULL);
+}
+
+
+/**
+ * @brief Plays a batch of games from a configuration on several threads
+ */
+int runGamesParallelWithConfig(const GameConfig* config, long long numGames,
+	int numThreads, GameResult* results, BatchStats* stats)
+{
+	return runParallel(config, numGames, numThreads, results, stats, 0, NULL);
+}
+
+
+/**
+ * @brief Plays and records a batch of games on several threads
+ */
+int runGamesParallelRecorded(const GameConfig* config, long long numGames,
+	int numThreads, FILE* recordFile, BatchStats* stats)
+{
+	return runParallel(config, numGames, numThreads, NULL, stats, 0, recordFile);
+}
+
+
+/**
+ * @brief Plays a batch of games on several threads with the lockstep engine
+ */
+int runGamesParallelBatch(int numPacks, int numPlayers, unsigned long long seed, long long numGames,
+	int numThreads, GameResult* results, BatchStats* stats)
+{
+	GameConfig config;
+	initGameConfig(&config, numPacks, (uint64_t)seed);
+	config.numPlayers = numPlayers;
+	return runParallel(&config, numGames, numThreads, results, stats, 1, NULL);
+}
+
+
+/**
+ * @brief Plays a batch of games from a configuration with the lockstep engine
+ */
+int runGamesParallelBatchWithConfig(const GameConfig* config, long long numGames,
+	int numThreads, GameResult* results, BatchStats* stats)
+{
+	return runParallel(config, numGames, numThreads, results, stats, 1, NULL);
+}
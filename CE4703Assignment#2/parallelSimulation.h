@@ -0,0 +1,123 @@
+/**
+ * @file parallelSimulation.h
+ * @brief Runs batches of games on several threads
+ *
+ * Games are independent, so a batch is cut into fixed-size chunks which
+ * are handed out to a pool of worker threads. Every game is seeded from
+ * its own index, never from the thread that plays it, so the results are
+ * the same for a given seed whatever the number of threads.
+ *
+ * @author Oluwatunmise Adegbola
+ * @date 17 October 2026
+*/
+
+#ifndef PARALLELSIMULATION_H
+#define PARALLELSIMULATION_H
+
+#include <stdio.h>
+
+#include "gameSimulation.h"
+
+#define MAX_THREADS 256
+
+/**
+  * @brief Returns the number of processors available to the program.
+  *
+  * @return Number of online processors, at least 1
+*/
+int defaultThreadCount(void);
+
+/**
+  * @brief Plays a batch of games silently on several threads.
+  *
+  * Game i is seeded with seed + i, exactly like runGames(), so any game of
+  * the batch can be replayed on its own with playGame().
+  *
+  * @param numPacks Number of card packs to use
+  * @param numPlayers Number of players
+  * @param seed Seed of the first game
+  * @param numGames Number of games to play
+  * @param numThreads Number of worker threads, 0 for one per processor
+  * @param results Array of numGames results to fill, or NULL if not needed
+  * @param stats Where to store the merged totals, cannot be NULL
+  * @return 1 on success, 0 if the worker threads could not be started
+*/
+int runGamesParallel(int numPacks, int numPlayers, unsigned long long seed, long long numGames,
+	int numThreads, GameResult* results, BatchStats* stats);
+
+/**
+  * @brief Plays a batch of games from a configuration on several threads.
+  *
+  * Same as runGamesParallel(), but every game gets the numPacks,
+  * numPlayers and strategies of the configuration; game i is seeded with
+  * config->seed + i. The sink and record are ignored, each worker uses
+  * its own NodePool.
+  *
+  * @param config Settings of every game, cannot be NULL
+  * @param numGames Number of games to play
+  * @param numThreads Number of worker threads, 0 for one per processor
+  * @param results Array of numGames results to fill, or NULL if not needed
+  * @param stats Where to store the merged totals, cannot be NULL
+  * @return 1 on success, 0 if the worker threads could not be started
+*/
+int runGamesParallelWithConfig(const GameConfig* config, long long numGames,
+	int numThreads, GameResult* results, BatchStats* stats);
+
+/**
+  * @brief Plays a batch of games like runGamesParallelWithConfig() and
+  * appends a record of every game to a stream.
+  *
+  * Each worker records into a temporary file of its own, so recording
+  * does not serialise the batch. After the workers are joined the files
+  * are copied to recordFile in game order, the same bytes a single thread
+  * recording the games one after the other would write.
+  *
+  * @param config Settings of every game, cannot be NULL
+  * @param numGames Number of games to play
+  * @param numThreads Number of worker threads, 0 for one per processor
+  * @param recordFile Stream to append the records to, cannot be NULL
+  * @param stats Where to store the merged totals, cannot be NULL
+  * @return 1 on success, 0 if the worker threads could not be started or
+  *         the records could not be written
+*/
+int runGamesParallelRecorded(const GameConfig* config, long long numGames,
+	int numThreads, FILE* recordFile, BatchStats* stats);
+
+/**
+  * @brief Same as runGamesParallel(), but each worker uses the lockstep
+  * batch engine (see batchSimulation.h).
+  *
+  * The games and their results are identical to runGamesParallel(); only
+  * the speed differs.
+  *
+  * @param numPacks Number of card packs to use
+  * @param numPlayers Number of players
+  * @param seed Seed of the first game
+  * @param numGames Number of games to play
+  * @param numThreads Number of worker threads, 0 for one per processor
+  * @param results Array of numGames results to fill, or NULL if not needed
+  * @param stats Where to store the merged totals, cannot be NULL
+  * @return 1 on success, 0 if the worker threads could not be started
+*/
+int runGamesParallelBatch(int numPacks, int numPlayers, unsigned long long seed, long long numGames,
+	int numThreads, GameResult* results, BatchStats* stats);
+
+/**
+  * @brief Same as runGamesParallelWithConfig(), but each worker uses the
+  * lockstep batch engine.
+  *
+  * The engine only plays the first matching card, so the strategies of
+  * the configuration are ignored; numPacks, numPlayers, seed, maxTurns
+  * and maxRepeats are used.
+  *
+  * @param config Settings of every game, cannot be NULL
+  * @param numGames Number of games to play
+  * @param numThreads Number of worker threads, 0 for one per processor
+  * @param results Array of numGames results to fill, or NULL if not needed
+  * @param stats Where to store the merged totals, cannot be NULL
+  * @return 1 on success, 0 if the worker threads could not be started
+*/
+int runGamesParallelBatchWithConfig(const GameConfig* config, long long numGames,
+	int numThreads, GameResult* results, BatchStats* stats);
+
+#endif // !PARALLELSIMULATION_H
@@ -0,0 +1,343 @@
+/**
+ * @file profiler.c
+ * @brief Per-thread phase timers, hardware counters and the flat profile
+ *
+ * @author Shrestha Dey
+ * @date 17 October 2026
+ */
+#include "profiler.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#if CARDGAME_PROFILE && CARDGAME_PROFILE_PERF && defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define PROFILE_USE_PERF 1
+#else
+#define PROFILE_USE_PERF 0
+#endif
+
+#define CALIBRATION_NS 20000000ULL  // how long printProfileReport() compares the tick counter with the clock
+#define COST_SCOPES 100000          // empty scopes timed to find what one costs
+
+#if CARDGAME_PROFILE
+
+PROFILE_THREAD_LOCAL ProfileData threadProfile;
+
+/// Measurements flushed by threads, only ever added to atomically
+static volatile unsigned long long totalCalls[NUM_PHASES];
+static volatile unsigned long long totalTotal[NUM_PHASES][NUM_METRICS];
+static volatile unsigned long long totalSelf[NUM_PHASES][NUM_METRICS];
+
+/**
+ * @brief Helper function to add to a total shared by all threads
+ *
+ * @param total Total to add to
+ * @param value Amount to add
+ */
+static void atomicAdd(volatile unsigned long long* total, unsigned long long value)
+{
+#ifdef _WIN32
+    InterlockedExchangeAdd64((volatile LONG64*)total, (LONG64)value);
+#else
+    __atomic_fetch_add(total, value, __ATOMIC_RELAXED);
+#endif
+}
+
+#endif
+
+#if PROFILE_USE_PERF
+
+/// Group leader of the thread's hardware counters, -1 while closed
+static PROFILE_THREAD_LOCAL int perfLeader = -1;
+/// Second counter of the group
+static PROFILE_THREAD_LOCAL int perfMember = -1;
+/// Whether the thread has tried to open its counters yet
+static PROFILE_THREAD_LOCAL bool perfTried;
+/// Set once any thread could not open its counters
+static volatile int perfRefused;
+
+/**
+ * @brief Helper function to open one hardware counter of the calling thread
+ *
+ * @param config PERF_COUNT_HW_* event
+ * @param leader Group leader, or -1 to start a group
+ * @return File descriptor, or -1 on failure
+ */
+static int openPerfCounter(unsigned long long config, int leader)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+}
+
+/**
+ * @brief Helper function to open the calling thread's counter group
+ */
+static void openPerfCounters(void)
+{
+    perfTried = true;
+    perfLeader = openPerfCounter(PERF_COUNT_HW_CACHE_MISSES, -1);
+    if (perfLeader >= 0) {
+        perfMember = openPerfCounter(PERF_COUNT_HW_BRANCH_MISSES, perfLeader);
+    }
+    if (perfLeader < 0 || perfMember < 0) {
+        if (perfLeader >= 0) {
+            close(perfLeader);
+        }
+        perfLeader = -1;
+        perfMember = -1;
+        perfRefused = 1;
+    }
+}
+
+#endif
+
+/**
+ * @brief Reads the monotonic clock, for processors without a usable
+ * time stamp counter
+ *
+ * @return Nanoseconds since an arbitrary start
+ */
+unsigned long long profileClockFallback(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (unsigned long long)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long long)now.tv_sec * 1000000000ULL + (unsigned long long)now.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Reads the calling thread's hardware counters
+ *
+ * Opens them on the first call. Stores zero when they are not available.
+ *
+ * @param values Where to store METRIC_CACHE_MISSES and METRIC_BRANCH_MISSES
+ */
+void profileReadHardware(unsigned long long* values)
+{
+    values[METRIC_CACHE_MISSES] = 0;
+    values[METRIC_BRANCH_MISSES] = 0;
+#if PROFILE_USE_PERF
+    if (!perfTried) {
+        openPerfCounters();
+    }
+    if (perfLeader < 0) {
+        return;
+    }
+
+    /// PERF_FORMAT_GROUP: the number of counters, then their values
+    unsigned long long group[3];
+    if (read(perfLeader, group, sizeof(group)) == (ssize_t)sizeof(group) && group[0] == 2) {
+        values[METRIC_CACHE_MISSES] = group[1];
+        values[METRIC_BRANCH_MISSES] = group[2];
+    }
+#endif
+}
+
+/**
+ * @brief Name of a phase
+ */
+const char* phaseName(ProfilePhase phase)
+{
+    static const char* const names[NUM_PHASES] = {
+        "initGame", "shuffleDeck", "dealInitialCards", "sortDeck",
+        "findMatchingCard", "drawCardForPlayer", "reshuffleHiddenDeck"
+    };
+    return phase >= 0 && phase < NUM_PHASES ? names[phase] : "unknown";
+}
+
+/**
+ * @brief Adds the calling thread's measurements to the process totals
+ */
+void flushThreadProfile(void)
+{
+#if CARDGAME_PROFILE
+    for (int p = 0; p < NUM_PHASES; p++) {
+        const PhaseProfile* phase = &threadProfile.phases[p];
+        if (!phase->calls) {
+            continue;
+        }
+        atomicAdd(&totalCalls[p], phase->calls);
+        for (int m = 0; m < NUM_METRICS; m++) {
+            atomicAdd(&totalTotal[p][m], phase->total[m]);
+            atomicAdd(&totalSelf[p][m], phase->self[m]);
+        }
+    }
+    memset(&threadProfile, 0, sizeof(threadProfile));
+#endif
+#if PROFILE_USE_PERF
+    /// closing the leader also closes the group
+    if (perfMember >= 0) {
+        close(perfMember);
+    }
+    if (perfLeader >= 0) {
+        close(perfLeader);
+    }
+    perfLeader = -1;
+    perfMember = -1;
+    perfTried = false;
+#endif
+}
+
+/**
+ * @brief Reads the process totals
+ */
+void readTotalProfile(ProfileData* out)
+{
+    memset(out, 0, sizeof(*out));
+#if CARDGAME_PROFILE
+    for (int p = 0; p < NUM_PHASES; p++) {
+        const PhaseProfile* local = &threadProfile.phases[p];
+        out->phases[p].calls = totalCalls[p] + local->calls;
+        for (int m = 0; m < NUM_METRICS; m++) {
+            out->phases[p].total[m] = totalTotal[p][m] + local->total[m];
+            out->phases[p].self[m] = totalSelf[p][m] + local->self[m];
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Helper function to measure tick counter ticks per nanosecond
+ *
+ * @return Ticks per nanosecond, 1 when the ticks are nanoseconds already
+ */
+static double ticksPerNs(void)
+{
+#if CARDGAME_PROFILE && PROFILE_HAS_TSC
+    unsigned long long startNs = profileClockFallback();
+    unsigned long long startTicks = profileTicks();
+    unsigned long long ns;
+    do {
+        ns = profileClockFallback() - startNs;
+    } while (ns < CALIBRATION_NS);
+    return (double)(profileTicks() - startTicks) / (double)ns;
+#else
+    return 1.0;
+#endif
+}
+
+/**
+ * @brief Helper function to measure what one empty scope costs
+ *
+ * Part of the cost falls between the two clock reads and is charged to
+ * the scope itself, the rest before and after them and is charged to the
+ * scope around it.
+ *
+ * @param inner Where to store the ticks charged to the scope itself
+ * @param outer Where to store the ticks charged to the enclosing scope
+ */
+static void scopeCost(double* inner, double* outer)
+{
+    *inner = 0.0;
+    *outer = 0.0;
+#if CARDGAME_PROFILE
+    /// time empty scopes, then put back what they recorded
+    ProfileData saved = threadProfile;
+    memset(&threadProfile, 0, sizeof(threadProfile));
+    unsigned long long start = profileTicks();
+    for (int i = 0; i < COST_SCOPES; i++) {
+        PROFILE_BEGIN(PHASE_FIND_MATCH);
+        PROFILE_END(PHASE_FIND_MATCH);
+    }
+    unsigned long long ticks = profileTicks() - start;
+    *inner = (double)threadProfile.phases[PHASE_FIND_MATCH].total[METRIC_TICKS] / COST_SCOPES;
+    *outer = (double)ticks / COST_SCOPES - *inner;
+    threadProfile = saved;
+#endif
+}
+
+/**
+ * @brief Prints a flat profile, the phases with the most self time first
+ */
+void printProfileReport(FILE* out, const ProfileData* profile, long long games)
+{
+    /// take the profiler's own cost off the times, so cheap, frequent
+    /// phases are not inflated by the timer; a phase's self scope count is
+    /// the scopes it opened directly, its total one all scopes below it
+    double inner;
+    double outer;
+    scopeCost(&inner, &outer);
+    double selfTicks[NUM_PHASES];
+    double totalTicks[NUM_PHASES];
+    double allSelfTicks = 0.0;
+    int order[NUM_PHASES];
+    for (int p = 0; p < NUM_PHASES; p++) {
+        const PhaseProfile* phase = &profile->phases[p];
+        selfTicks[p] = (double)phase->self[METRIC_TICKS] - inner * (double)phase->calls
+            - outer * (double)phase->self[METRIC_SCOPES];
+        totalTicks[p] = (double)phase->total[METRIC_TICKS] - inner * (double)phase->calls
+            - (inner + outer) * (double)phase->total[METRIC_SCOPES];
+        if (selfTicks[p] < 0.0) {
+            selfTicks[p] = 0.0;
+        }
+        if (totalTicks[p] < selfTicks[p]) {
+            totalTicks[p] = selfTicks[p];
+        }
+        allSelfTicks += selfTicks[p];
+        order[p] = p;
+    }
+
+    /// insertion sort on self time, there are only a handful of phases
+    for (int i = 1; i < NUM_PHASES; i++) {
+        int p = order[i];
+        int j = i;
+        while (j > 0 && selfTicks[order[j - 1]] < selfTicks[p]) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = p;
+    }
+
+    double nsPerTick = 1.0 / ticksPerNs();
+    fprintf(out, "phase,calls,calls_per_game,self_ms,self_pct,total_ms,self_ns_per_call");
+#if CARDGAME_PROFILE_PERF
+    fprintf(out, ",self_cache_misses,self_branch_misses");
+#endif
+    fprintf(out, "\n");
+
+    for (int i = 0; i < NUM_PHASES; i++) {
+        const PhaseProfile* phase = &profile->phases[order[i]];
+        double selfNs = selfTicks[order[i]] * nsPerTick;
+        fprintf(out, "%s,%llu,%.3f,%.3f,%.2f,%.3f,%.1f", phaseName((ProfilePhase)order[i]), phase->calls,
+            games > 0 ? (double)phase->calls / (double)games : 0.0,
+            selfNs / 1e6,
+            allSelfTicks > 0.0 ? 100.0 * selfTicks[order[i]] / allSelfTicks : 0.0,
+            totalTicks[order[i]] * nsPerTick / 1e6,
+            phase->calls ? selfNs / (double)phase->calls : 0.0);
+#if CARDGAME_PROFILE_PERF
+        fprintf(out, ",%llu,%llu", phase->self[METRIC_CACHE_MISSES], phase->self[METRIC_BRANCH_MISSES]);
+#endif
+        fprintf(out, "\n");
+    }
+    fprintf(out, "# times exclude the %.1f ns each scope costs\n", (inner + outer) * nsPerTick);
+
+#if PROFILE_USE_PERF
+    if (perfRefused) {
+        fprintf(out, "# hardware counters unavailable (see /proc/sys/kernel/perf_event_paranoid), misses read as 0\n");
+    }
+#elif CARDGAME_PROFILE_PERF
+    fprintf(out, "# hardware counters need Linux perf_event_open(), misses read as 0\n");
+#endif
+}
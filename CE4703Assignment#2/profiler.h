@@ -0,0 +1,237 @@
+/**
+ * @file profiler.h
+ * @brief Scoped timers for the phases of a game
+ *
+ * The profiler only exists when the program is built with
+ * CARDGAME_PROFILE=1 (the CMake option of the same name). Otherwise
+ * PROFILE_BEGIN() and PROFILE_END() expand to nothing, like the
+ * operation counters in counters.h.
+ *
+ * A scope reads the time stamp counter when it opens and when it closes,
+ * which costs a few dozen cycles on x86, so the profiler can stay on for
+ * whole batch runs. Other processors fall back to the monotonic clock.
+ * Scopes nest: a phase's total time includes the phases it calls (a
+ * reshuffle inside a draw), its self time does not, so the self times of
+ * all phases add up to the profiled time without counting anything twice.
+ * The report measures what an empty scope costs and takes that off for
+ * every scope, so a phase of a few nanoseconds is not buried under the
+ * cost of timing it.
+ *
+ * Built with CARDGAME_PROFILE_PERF=1 as well, on Linux each scope also
+ * reads the thread's cache miss and branch miss counters through
+ * perf_event_open(). That is a system call per scope end, so it is for
+ * finding out where misses come from, not for timing. When the kernel
+ * refuses the counters they read as zero and the report says so.
+ *
+ * Like the counters, each thread times into its own thread-local block
+ * and adds it to the process totals with flushThreadProfile() before it
+ * exits.
+ *
+ * @author Shrestha Dey
+ * @date 17 October 2026
+ */
+
+#pragma once
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#ifndef CARDGAME_PROFILE
+#define CARDGAME_PROFILE 0
+#endif
+
+#ifndef CARDGAME_PROFILE_PERF
+#define CARDGAME_PROFILE_PERF 0
+#endif
+
+/**
+ * @brief What is timed
+ */
+typedef enum {
+    PHASE_INIT_GAME,        ///< initGameWithConfig(), the first shuffle included
+    PHASE_SHUFFLE,          ///< shuffleDeck()
+    PHASE_DEAL,             ///< dealInitialCards()
+    PHASE_SORT,             ///< sortDeck() calls that sorted two cards or more
+    PHASE_FIND_MATCH,       ///< findMatchingCard()
+    PHASE_DRAW,             ///< drawCardForPlayer(), reshuffles included
+    PHASE_RESHUFFLE,        ///< reshuffleHiddenDeck(), its shuffle included
+    NUM_PHASES
+} ProfilePhase;
+
+/**
+ * @brief What is measured in each scope
+ */
+typedef enum {
+    METRIC_TICKS,           ///< time stamp counter ticks, or nanoseconds without one
+    METRIC_SCOPES,          ///< scopes opened, to take the profiler's own cost off the times
+    METRIC_CACHE_MISSES,    ///< last level cache misses, CARDGAME_PROFILE_PERF only
+    METRIC_BRANCH_MISSES,   ///< mispredicted branches, CARDGAME_PROFILE_PERF only
+    NUM_METRICS
+} ProfileMetric;
+
+/**
+ * @brief Everything measured for one phase
+ */
+typedef struct {
+    unsigned long long calls;               ///< Scopes closed
+    unsigned long long total[NUM_METRICS];  ///< Measured in the phase and the phases it called
+    unsigned long long self[NUM_METRICS];   ///< Measured in the phase alone
+} PhaseProfile;
+
+/**
+ * @brief One block per thread, and one for the process totals
+ */
+typedef struct {
+    PhaseProfile phases[NUM_PHASES];        ///< Measurements, by ProfilePhase
+    unsigned long long child[NUM_METRICS];  ///< Measured in closed scopes inside the open one
+    unsigned long long scopes;              ///< Scopes opened so far
+} ProfileData;
+
+/**
+ * @brief An open scope, lives on the stack of the timed function
+ */
+typedef struct {
+    unsigned long long start[NUM_METRICS];  ///< Readings when the scope opened
+    unsigned long long outerChild[NUM_METRICS]; ///< child[] of the enclosing scope
+} ProfileScope;
+
+/**
+ * @brief Reads the monotonic clock in nanoseconds, the ticks of
+ * processors without a time stamp counter
+ */
+unsigned long long profileClockFallback(void);
+
+/**
+ * @brief Reads the calling thread's cache and branch miss counters,
+ * opening them on first use
+ *
+ * @param values Where to store them, by ProfileMetric; zero when unavailable
+ */
+void profileReadHardware(unsigned long long* values);
+
+#if CARDGAME_PROFILE
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define PROFILE_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROFILE_HAS_TSC 1
+#else
+#define PROFILE_HAS_TSC 0
+#endif
+
+#ifdef _MSC_VER
+#define PROFILE_THREAD_LOCAL __declspec(thread)
+#else
+#define PROFILE_THREAD_LOCAL _Thread_local
+#endif
+
+/// Metrics the scopes measure, the misses only with CARDGAME_PROFILE_PERF
+#define PROFILE_METRICS (CARDGAME_PROFILE_PERF ? NUM_METRICS : METRIC_SCOPES + 1)
+
+/// Measurements of the calling thread since it started or last flushed
+extern PROFILE_THREAD_LOCAL ProfileData threadProfile;
+
+/**
+ * @brief Reads the tick counter
+ */
+static inline unsigned long long profileTicks(void)
+{
+#if PROFILE_HAS_TSC
+    return __rdtsc();
+#else
+    return profileClockFallback();
+#endif
+}
+
+/**
+ * @brief Opens a scope
+ */
+static inline void profileBegin(ProfileScope* scope)
+{
+    for (int m = 0; m < PROFILE_METRICS; m++) {
+        scope->outerChild[m] = threadProfile.child[m];
+        threadProfile.child[m] = 0;
+    }
+#if CARDGAME_PROFILE_PERF
+    profileReadHardware(scope->start);
+#endif
+    /// read the clock last so the hardware read is not timed
+    scope->start[METRIC_SCOPES] = ++threadProfile.scopes;
+    scope->start[METRIC_TICKS] = profileTicks();
+}
+
+/**
+ * @brief Closes a scope and charges it to a phase
+ */
+static inline void profileEnd(ProfileScope* scope, ProfilePhase phase)
+{
+    unsigned long long now[NUM_METRICS];
+    now[METRIC_TICKS] = profileTicks();
+    now[METRIC_SCOPES] = threadProfile.scopes;
+#if CARDGAME_PROFILE_PERF
+    profileReadHardware(now);
+#endif
+
+    PhaseProfile* profile = &threadProfile.phases[phase];
+    profile->calls++;
+    for (int m = 0; m < PROFILE_METRICS; m++) {
+        unsigned long long spent = now[m] - scope->start[m];
+        profile->total[m] += spent;
+        profile->self[m] += spent - threadProfile.child[m];
+        /// the enclosing scope sees this one as a child
+        threadProfile.child[m] = scope->outerChild[m] + spent;
+    }
+}
+
+#define PROFILE_BEGIN(phase) ProfileScope profileScope_##phase; profileBegin(&profileScope_##phase)
+#define PROFILE_END(phase) profileEnd(&profileScope_##phase, phase)
+
+#else
+
+#define PROFILE_BEGIN(phase) ((void)0)
+#define PROFILE_END(phase) ((void)0)
+
+#endif
+
+/**
+ * @brief Name of a phase, as printed in the report
+ *
+ * @param phase Phase
+ * @return Name of the function the phase times
+ */
+const char* phaseName(ProfilePhase phase);
+
+/**
+ * @brief Adds the calling thread's measurements to the process totals
+ * and zeroes them
+ *
+ * Safe to call from several threads at once. Also closes the thread's
+ * hardware counters. Does nothing when the profiler is off.
+ */
+void flushThreadProfile(void);
+
+/**
+ * @brief Reads the process totals, the calling thread's unflushed
+ * measurements included
+ *
+ * @param out Where to store the totals, all zero when the profiler is off
+ */
+void readTotalProfile(ProfileData* out);
+
+/**
+ * @brief Prints a flat profile, the phases with the most self time first
+ *
+ * Ticks are converted to nanoseconds with a short calibration against
+ * the monotonic clock.
+ *
+ * @param out Stream to print to
+ * @param profile Measurements to print
+ * @param games Games the measurements cover, for the per-game column
+ */
+void printProfileReport(FILE* out, const ProfileData* profile, long long games);
+
+#endif // !PROFILER_H
@@ -0,0 +1,27 @@
+/**
+ * @file rng.c
+ * @brief Implementation of the seedable random number generator
+ *
+ * nextRandom() and randomBelow() are inline in rng.h; this file only
+ * holds the seeding routine.
+ *
+ * @author Shrestha Dey
+ * @date 17 October 2026
+ */
+#include "rng.h"
+
+/**
+ * @brief Seeds a generator
+ *
+ * Each state word is one SplitMix64 output, as recommended by the
+ * xoshiro authors.
+ */
+void seedRng(Rng* rng, uint64_t seed)
+{
+    for (int i = 0; i < 4; i++) {
+        uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        rng->s[i] = z ^ (z >> 31);
+    }
+}
@@ -0,0 +1,101 @@
+/**
+ * @file rng.h
+ * @brief Small seedable pseudo-random number generator
+ *
+ * The generator state is an explicit value instead of the hidden global
+ * state behind rand(), so every deck can carry its own stream. Two
+ * generators seeded with the same value produce the same sequence, and
+ * generators used from different threads never interfere.
+ *
+ * The generator is xoshiro256** (Blackman and Vigna): 256 bits of state,
+ * a period of 2^256 - 1 and only a few shifts and multiplies per number.
+ * Bounded values use Lemire's multiply-and-reject method, which is
+ * unbiased for every bound and almost never needs a second draw. Both are
+ * inline because shuffleDeck() calls them once per card.
+ *
+ * @author Shrestha Dey
+ * @date 17 October 2026
+ */
+
+#pragma once
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+/**
+ * @brief State of one random number stream (xoshiro256**)
+ */
+typedef struct {
+    uint64_t s[4];  ///< Generator state, never all zero
+} Rng;
+
+/**
+ * @brief Seeds a generator
+ *
+ * The 64-bit seed is expanded into the full state with SplitMix64, so
+ * nearby seeds (seed, seed + 1, ...) still give unrelated streams.
+ *
+ * @param rng Generator to seed, cannot be NULL
+ * @param seed Any 64-bit value; equal seeds give equal sequences
+ */
+void seedRng(Rng* rng, uint64_t seed);
+
+/**
+ * @brief Helper to rotate a 64-bit value left
+ */
+static inline uint64_t rotateLeft(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * @brief Returns the next 64 random bits of the stream
+ *
+ * @param rng Generator, cannot be NULL
+ * @return Uniformly distributed 64-bit value
+ */
+static inline uint64_t nextRandom(Rng* rng)
+{
+    uint64_t* s = rng->s;
+    uint64_t result = rotateLeft(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotateLeft(s[3], 45);
+
+    return result;
+}
+
+/**
+ * @brief Returns a random integer in the range [0, bound) without bias
+ *
+ * Works for any bound up to 2^32 - 1, so decks of any size are shuffled
+ * uniformly (rand() stops at RAND_MAX, which is only 32767 on MSVC).
+ *
+ * @param rng Generator, cannot be NULL
+ * @param bound Exclusive upper limit, must be greater than 0
+ * @return Value between 0 and bound-1
+ */
+static inline uint32_t randomBelow(Rng* rng, uint32_t bound)
+{
+    uint64_t m = (nextRandom(rng) >> 32) * bound;
+    uint32_t low = (uint32_t)m;
+
+    if (low < bound) {
+        /// Reject the few values that would make some results more likely
+        uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold) {
+            m = (nextRandom(rng) >> 32) * bound;
+            low = (uint32_t)m;
+        }
+    }
+
+    return (uint32_t)(m >> 32);
+}
+
+#endif
@@ -6,21 +6,208 @@
  *
  * This file implements the sortDeck function declared in sort.h.
  * The function uses the compareCards function from card.c.
+ * sortDeck counts cards by their (suit, rank) key, sortDeckWith is a
+ * stable merge sort for other orders.
  *
  * @author Mabh McCarthy
  * @date 26 November 2025
  */
 
+#include "counters.h"
+#include "profiler.h"
 #include "sort.h"
 #include <stdio.h>
 #include <stdlib.h>
 
 /**
  * @brief Sorts deck of cards based on suit and rank
+ *
+ * Two passes: count how many of each card there are, then overwrite the
+ * deck from the top with the cards in key order.
+ */
+void sortDeck(CardDeck* deck)
+{
+    if (deck == NULL) return;
+    if (deck->sorted) {
+        COUNT_OP(COUNTER_SORTS_SKIPPED);
+        return;
+    }
+    COUNT_OP(COUNTER_SORTS);
+    deck->sorted = true;
+    deck->unshuffled = 0;  /// a pending lazy shuffle is pointless once sorted
+    if (deck->size <= 1) return;
+    PROFILE_BEGIN(PHASE_SORT);
+
+    int counts[NUM_CARD_TYPES] = { 0 };
+    DeckIterator it = deckBegin(deck);
+    const Card* card;
+    while ((card = deckNext(&it)) != NULL) {
+        if (!isValidCard(*card)) {
+            /// No counter for an out of range card, compare them instead
+            PROFILE_END(PHASE_SORT);
+            sortDeckWith(deck, compareCards);
+            return;
+        }
+        counts[packCard(*card)]++;
+    }
+
+#if DECK_RING_BUFFER
+    Card* out = linearizeDeck(deck);
+    for (int key = 0; key < NUM_CARD_TYPES; key++) {
+        Card c = unpackCard((PackedCard)key);
+        for (int n = counts[key]; n > 0; n--) {
+            *out++ = c;
+        }
+    }
+#else
+    CardNode* node = deck->head;
+    for (int key = 0; key < NUM_CARD_TYPES; key++) {
+        Card c = unpackCard((PackedCard)key);
+        for (int n = counts[key]; n > 0; n--) {
+            node->card = c;
+            node = node->next;
+        }
+    }
+#endif
+    PROFILE_END(PHASE_SORT);
+}
+
+#if DECK_RING_BUFFER
+/**
+ * @brief Helper for sortDeckWith: merge sort of cards[from, to) using temp
+ */
+static void mergeSortCards(Card* cards, Card* temp, int from, int to, CardComparator compare)
+{
+    if (to - from < 2) return;
+
+    int mid = from + (to - from) / 2;
+    mergeSortCards(cards, temp, from, mid, compare);
+    mergeSortCards(cards, temp, mid, to, compare);
+
+    /// Already in order, nothing to merge
+    if (compare(&cards[mid - 1], &cards[mid]) <= 0) return;
+
+    int i = from, j = mid, k = from;
+    while (i < mid && j < to) {
+        /// Take from the left run on ties to keep the sort stable
+        temp[k++] = (compare(&cards[j], &cards[i]) < 0) ? cards[j++] : cards[i++];
+    }
+    while (i < mid) temp[k++] = cards[i++];
+    while (j < to) temp[k++] = cards[j++];
+    for (k = from; k < to; k++) {
+        cards[k] = temp[k];
+    }
+}
+#else
+/**
+ * @brief Helper for sortDeckWith: merges two sorted node lists
+ */
+static CardNode* mergeNodes(CardNode* a, CardNode* b, CardComparator compare)
+{
+    CardNode head;
+    CardNode* tail = &head;
+
+    while (a != NULL && b != NULL) {
+        /// Take from the first list on ties to keep the sort stable
+        if (compare(&b->card, &a->card) < 0) {
+            tail->next = b;
+            b = b->next;
+        }
+        else {
+            tail->next = a;
+            a = a->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = (a != NULL) ? a : b;
+    return head.next;
+}
+
+/**
+ * @brief Helper for sortDeckWith: merge sort of a node list of length n
+ */
+static CardNode* mergeSortNodes(CardNode* list, int n, CardComparator compare)
+{
+    if (n < 2) {
+        if (list != NULL) list->next = NULL;
+        return list;
+    }
+
+    /// Split after the first half
+    int half = n / 2;
+    CardNode* second = list;
+    for (int i = 0; i < half; i++) {
+        second = second->next;
+    }
+
+    CardNode* left = mergeSortNodes(list, half, compare);
+    CardNode* right = mergeSortNodes(second, n - half, compare);
+    return mergeNodes(left, right, compare);
+}
+#endif
+
+/**
+ * @brief Sorts cards with a custom comparison function
  */
-void sortDeck(CardDeck* deck) 
+void sortDeckWith(CardDeck* deck, CardComparator compare)
 {
-    if (deck == NULL || deck->head == NULL) return;
+    if (deck == NULL || compare == NULL) return;
+    deck->unshuffled = 0;
+    /// Only the compareCards() order is tracked by the sorted flag
+    deck->sorted = (compare == compareCards) || deck->size <= 1;
+    if (deck->size <= 1) return;
+
+#if DECK_RING_BUFFER
+    Card* cards = linearizeDeck(deck);
+    Card* temp = malloc((size_t)deck->size * sizeof(Card));
+    if (temp == NULL) {
+        /// No memory for the merge buffer, fall back to a stable insertion sort
+        for (int i = 1; i < deck->size; i++) {
+            Card c = cards[i];
+            int j = i;
+            while (j > 0 && compare(&c, &cards[j - 1]) < 0) {
+                cards[j] = cards[j - 1];
+                j--;
+            }
+            cards[j] = c;
+        }
+        return;
+    }
+    mergeSortCards(cards, temp, 0, deck->size, compare);
+    free(temp);
+#else
+    deck->head = mergeSortNodes(deck->head, deck->size, compare);
+    CardNode* tail = deck->head;
+    while (tail->next != NULL) {
+        tail = tail->next;
+    }
+    deck->tail = tail;
+#endif
+}
+
+/**
+ * @brief Original exchange sort based on suit and rank
+ */
+void exchangeSortDeck(CardDeck* deck) 
+{
+    if (deck == NULL) return;
+    deck->sorted = true;
+    deck->unshuffled = 0;
+#if DECK_RING_BUFFER
+    if (deck->size == 0) return;
+    Card* cards = linearizeDeck(deck);
+    Card blank;
+    for (int i = 0; i < deck->size; i++) {
+        for (int j = i + 1; j < deck->size; j++) {
+            if (compareCards(&cards[i], &cards[j]) > 0) {
+                blank = cards[i];
+                cards[i] = cards[j];
+                cards[j] = blank;
+            }
+        }
+    }
+#else
+    if (deck->head == NULL) return;
     CardNode* i;
     CardNode* j;
     Card blank;
@@ -33,4 +220,5 @@ void sortDeck(CardDeck* deck)
             }
         }
     }
+#endif
 }
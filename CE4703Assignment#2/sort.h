@@ -15,9 +15,46 @@
 #include "card.h"
 #include "deck.h"
 
+ /**
+ * @brief Comparison function used by sortDeckWith()
+ *
+ * Same contract as compareCards(): negative if a comes first, positive
+ * if b comes first, 0 if they are equivalent.
+ */
+typedef int (*CardComparator)(const Card* a, const Card* b);
+
  /**
  * @brief  Function to sort cards
+ *
+ * Sorts the deck into compareCards() order (suit, then rank) with a
+ * counting sort over the 52 possible cards, so it runs in O(n) for any
+ * number of packs. Equal cards are indistinguishable, so the result is
+ * the same as any stable sort. Does nothing if the deck's sorted flag
+ * says it is already in order (see insertCardSorted()).
+ *
+ * @param deck Deck to sort, may be NULL or empty
  */
 void sortDeck(CardDeck* deck);
 
+ /**
+ * @brief Sorts cards with a custom comparison function
+ *
+ * Stable merge sort: O(n log n), cards that compare equal keep their
+ * relative order. The linked list is sorted by relinking nodes, the ring
+ * buffer through a temporary array.
+ *
+ * @param deck Deck to sort, may be NULL or empty
+ * @param compare Comparison function, cannot be NULL
+ */
+void sortDeckWith(CardDeck* deck, CardComparator compare);
+
+ /**
+ * @brief Original O(n^2) exchange sort
+ *
+ * Kept as the reference implementation for benchmarks and cross-checks.
+ *
+ * @param deck Deck to sort, may be NULL or empty
+ */
+void exchangeSortDeck(CardDeck* deck);
+
 #endif
@@ -0,0 +1,280 @@
+/**
+ * @file statistics.c
+ * @brief Streaming statistics: running moments, log histograms, intervals
+ *
+ * @author Oluwatunmise Adegbola
+ * @date 17 October 2026
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "statistics.h"
+
+#define HISTOGRAM_LINEAR_BITS 4	// log2 of HISTOGRAM_LINEAR
+
+
+/**
+ * @brief Empties a running statistic
+ *
+ * @param stat Statistic to reset
+*/
+void initRunningStat(RunningStat* stat)
+{
+	memset(stat, 0, sizeof(*stat));
+}
+
+
+/**
+ * @brief Adds one value (Welford's update)
+ *
+ * @param stat Statistic to update
+ * @param value New value
+*/
+void addRunningStat(RunningStat* stat, double value)
+{
+	if (stat -> count == 0 || value < stat -> min) {
+		stat -> min = value;
+	}
+	if (stat -> count == 0 || value > stat -> max) {
+		stat -> max = value;
+	}
+
+	stat -> count++;
+	double delta = value - stat -> mean;
+	stat -> mean += delta / (double)stat -> count;
+	stat -> m2 += delta * (value - stat -> mean);
+}
+
+
+/**
+ * @brief Merges the values of one statistic into another
+ *
+ * Chan, Golub and LeVeque's pairwise update: the result is what one
+ * statistic fed both streams would hold, up to rounding.
+ *
+ * @param into Statistic to update
+ * @param from Statistic to add, left unchanged
+*/
+void mergeRunningStat(RunningStat* into, const RunningStat* from)
+{
+	if (from -> count == 0) {
+		return;
+	}
+	if (into -> count == 0) {
+		*into = *from;
+		return;
+	}
+
+	double n1 = (double)into -> count;
+	double n2 = (double)from -> count;
+	double n = n1 + n2;
+	double delta = from -> mean - into -> mean;
+
+	into -> mean += delta * n2 / n;
+	into -> m2 += from -> m2 + delta * delta * n1 * n2 / n;
+	into -> count += from -> count;
+	if (from -> min < into -> min) {
+		into -> min = from -> min;
+	}
+	if (from -> max > into -> max) {
+		into -> max = from -> max;
+	}
+}
+
+
+/**
+ * @brief Sample variance of the values
+ *
+ * @param stat Statistic
+ * @return Variance with n - 1 in the denominator, 0 for fewer than two values
+*/
+double runningVariance(const RunningStat* stat)
+{
+	return stat -> count > 1 ? stat -> m2 / (double)(stat -> count - 1) : 0.0;
+}
+
+
+/**
+ * @brief Sample standard deviation of the values
+ *
+ * @param stat Statistic
+ * @return Standard deviation, 0 for fewer than two values
+*/
+double runningStdDev(const RunningStat* stat)
+{
+	return sqrt(runningVariance(stat));
+}
+
+
+/**
+ * @brief Half width of a normal confidence interval for the mean
+ *
+ * @param stat Statistic
+ * @param z Normal quantile, CONFIDENCE_Z95 for 95%
+ * @return z times the standard error, 0 for fewer than two values
+*/
+double runningConfidence(const RunningStat* stat, double z)
+{
+	return stat -> count > 1 ? z * runningStdDev(stat) / sqrt((double)stat -> count) : 0.0;
+}
+
+
+/**
+ * @brief Empties a histogram
+ *
+ * @param histogram Histogram to reset
+*/
+void initHistogram(Histogram* histogram)
+{
+	memset(histogram, 0, sizeof(*histogram));
+}
+
+
+/**
+ * @brief Bucket a value is counted in
+ *
+ * @param value Value, negative values count as 0 and values past INT_MAX
+ *        go to the last bucket
+ * @return Bucket index, 0 to HISTOGRAM_BUCKETS - 1
+*/
+int histogramBucket(long long value)
+{
+	if (value < HISTOGRAM_LINEAR) {
+		return value < 0 ? 0 : (int)value;
+	}
+
+	int exponent = HISTOGRAM_LINEAR_BITS;	// value is in [2^exponent, 2^(exponent + 1))
+	while (exponent < 62 && (value >> (exponent + 1)) != 0) {
+		exponent++;
+	}
+
+	int sub = (int)(value >> (exponent - HISTOGRAM_SUB_BITS)) & (HISTOGRAM_SUB_BUCKETS - 1);
+	int bucket = HISTOGRAM_LINEAR + (exponent - HISTOGRAM_LINEAR_BITS) * HISTOGRAM_SUB_BUCKETS + sub;
+	return bucket < HISTOGRAM_BUCKETS ? bucket : HISTOGRAM_BUCKETS - 1;
+}
+
+
+/**
+ * @brief Smallest value of a bucket
+ *
+ * @param bucket Bucket index
+ * @return Lowest value counted in the bucket
+*/
+long long histogramBucketLow(int bucket)
+{
+	if (bucket < HISTOGRAM_LINEAR) {
+		return bucket;
+	}
+
+	int exponent = (bucket - HISTOGRAM_LINEAR) / HISTOGRAM_SUB_BUCKETS + HISTOGRAM_LINEAR_BITS;
+	int sub = (bucket - HISTOGRAM_LINEAR) % HISTOGRAM_SUB_BUCKETS;
+	return (long long)(HISTOGRAM_SUB_BUCKETS + sub) << (exponent - HISTOGRAM_SUB_BITS);
+}
+
+
+/**
+ * @brief Largest value of a bucket
+ *
+ * @param bucket Bucket index
+ * @return Highest value counted in the bucket
+*/
+long long histogramBucketHigh(int bucket)
+{
+	return histogramBucketLow(bucket + 1) - 1;
+}
+
+
+/**
+ * @brief Counts one value
+ *
+ * @param histogram Histogram to update
+ * @param value Value to count
+*/
+void addToHistogram(Histogram* histogram, long long value)
+{
+	histogram -> counts[histogramBucket(value)]++;
+	histogram -> total++;
+}
+
+
+/**
+ * @brief Adds the counts of one histogram to another
+ *
+ * @param into Histogram to update
+ * @param from Histogram to add, left unchanged
+*/
+void mergeHistogram(Histogram* into, const Histogram* from)
+{
+	for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+		into -> counts[i] += from -> counts[i];
+	}
+	into -> total += from -> total;
+}
+
+
+/**
+ * @brief Value below which a fraction of the counted values lie
+ *
+ * Finds the bucket holding the value of rank ceil(fraction * total) and
+ * returns its middle, so the answer is within 1/16 of the exact one
+ * (exact below HISTOGRAM_LINEAR).
+ *
+ * @param histogram Histogram
+ * @param fraction Fraction between 0 and 1, 0.5 for the median
+ * @return Percentile value, 0 for an empty histogram
+*/
+long long histogramPercentile(const Histogram* histogram, double fraction)
+{
+	if (histogram -> total == 0) {
+		return 0;
+	}
+
+	long long rank = (long long)ceil(fraction * (double)histogram -> total);
+	if (rank < 1) {
+		rank = 1;
+	}
+	if (rank > histogram -> total) {
+		rank = histogram -> total;
+	}
+
+	long long seen = 0;
+	for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+		seen += histogram -> counts[i];
+		if (seen >= rank) {
+			return (histogramBucketLow(i) + histogramBucketHigh(i)) / 2;
+		}
+	}
+	return histogramBucketLow(HISTOGRAM_BUCKETS - 1);
+}
+
+
+/**
+ * @brief Wilson score interval of a proportion
+ *
+ * Unlike the normal approximation it stays inside [0, 1] and behaves
+ * for rates near 0 or 1, such as the win rate of a weak seat.
+ *
+ * @param successes Number of successes
+ * @param trials Number of trials
+ * @param z Normal quantile, CONFIDENCE_Z95 for 95%
+ * @param low Where to store the lower bound
+ * @param high Where to store the upper bound
+*/
+void proportionInterval(long long successes, long long trials, double z, double* low, double* high)
+{
+	if (trials <= 0) {
+		*low = 0.0;
+		*high = 1.0;
+		return;
+	}
+
+	double n = (double)trials;
+	double p = (double)successes / n;
+	double z2 = z * z;
+	double centre = (p + z2 / (2.0 * n)) / (1.0 + z2 / n);
+	double half = z * sqrt(p * (1.0 - p) / n + z2 / (4.0 * n * n)) / (1.0 + z2 / n);
+
+	*low = centre - half;
+	*high = centre + half;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file statistics.h
+ * @brief Streaming statistics: running moments, log histograms, intervals
+ *
+ * Everything here takes one value at a time in constant memory, so the
+ * numbers of a run do not depend on keeping per-game rows around, and
+ * two accumulators of the same kind merge into the one that would have
+ * seen both streams.
+ *
+ * RunningStat keeps the count, mean and sum of squared deviations with
+ * Welford's update, which stays accurate where the naive sum of squares
+ * cancels, and merges with the pairwise formula of Chan, Golub and
+ * LeVeque. Merging is exact for the count, minimum and maximum; the
+ * moments agree with a single pass up to rounding, and merging in a fixed
+ * order gives the same bits every time.
+ *
+ * Histogram counts non-negative integers in log buckets: every value
+ * below HISTOGRAM_LINEAR has its own bucket, and each power of two above
+ * that is split into HISTOGRAM_SUB_BUCKETS buckets, so a bucket is never
+ * wider than 1/8 of its values. Counts are integers, so histograms merge
+ * exactly in any order; percentiles are read back to within 1/16.
+ *
+ * @author Oluwatunmise Adegbola
+ * @date 17 October 2026
+*/
+
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+#define HISTOGRAM_LINEAR 16	// values with a bucket of their own
+#define HISTOGRAM_SUB_BITS 3
+#define HISTOGRAM_SUB_BUCKETS (1 << HISTOGRAM_SUB_BITS)	// buckets per power of two
+#define HISTOGRAM_BUCKETS (HISTOGRAM_LINEAR + 27 * HISTOGRAM_SUB_BUCKETS)	// powers of two 2^4 to 2^30, so up to INT_MAX
+#define CONFIDENCE_Z95 1.959963984540054	// normal quantile of a two-sided 95% interval
+
+/**
+  * @brief Count, mean and spread of a stream of values
+*/
+typedef struct RunningStat {
+	long long count;	// values seen
+	double mean;	// mean of the values
+	double m2;	// sum of squared deviations from the mean
+	double min;	// smallest value, 0 while empty
+	double max;	// largest value, 0 while empty
+} RunningStat;
+
+/**
+  * @brief Counts of values in log buckets
+*/
+typedef struct Histogram {
+	long long counts[HISTOGRAM_BUCKETS];	// values per bucket
+	long long total;	// values counted
+} Histogram;
+
+/* --- running moments --- */
+void initRunningStat(RunningStat* stat);
+void addRunningStat(RunningStat* stat, double value);
+void mergeRunningStat(RunningStat* into, const RunningStat* from);
+double runningVariance(const RunningStat* stat);
+double runningStdDev(const RunningStat* stat);
+double runningConfidence(const RunningStat* stat, double z);
+
+/* --- histograms --- */
+void initHistogram(Histogram* histogram);
+int histogramBucket(long long value);
+long long histogramBucketLow(int bucket);
+long long histogramBucketHigh(int bucket);
+void addToHistogram(Histogram* histogram, long long value);
+void mergeHistogram(Histogram* into, const Histogram* from);
+long long histogramPercentile(const Histogram* histogram, double fraction);
+
+/* --- proportions --- */
+void proportionInterval(long long successes, long long trials, double z, double* low, double* high);
+
+#endif // !STATISTICS_H
@@ -0,0 +1,252 @@
+/**
+ * @file strategy.c
+ * @brief Built-in player strategies and the strategy call in the game loop
+ *
+ * Every built-in works on the 13-bit rank masks of the HandIndex: the
+ * playable cards of a suit are the whole suit if it is the current suit,
+ * otherwise just the current rank. That is at most 16 candidates, walked
+ * in sorted order so ties always go to the card findMatchingCard() would
+ * pick.
+ *
+ * @author Oluwatunmise Adegbola
+ * @date 17 October 2026
+*/
+
+#include <string.h>
+
+#include "strategy.h"
+
+
+/**
+ * @brief Ranks of one suit that can be played on the current card
+ *
+ * @param hand Player's hand
+ * @param current Card to match
+ * @param suit Suit to look at
+ * @return Bit (rank - TWO) set for every playable rank held in the suit
+ */
+static uint16_t playableRanks(const HandIndex* hand, const Card* current, int suit)
+{
+	if (suit == (int)current -> suit) {
+		return hand -> suitMasks[suit];
+	}
+	return hand -> suitMasks[suit] & (uint16_t)(1u << ((int)current -> rank - TWO));
+}
+
+
+/**
+ * @brief Index of the lowest set bit of a non-zero rank mask
+ */
+static int lowestRank(uint16_t mask)
+{
+	int r = 0;
+	while (!(mask & (1u << r))) {
+		r++;
+	}
+	return r;
+}
+
+
+/**
+ * @brief Sorted-hand position of a held card
+ */
+static int positionOf(const GameView* view, int suit, int rank)
+{
+	Card card = { (Suit)suit, (Rank)(rank + TWO) };
+	return handPositionOf(view -> hand, card);
+}
+
+
+/**
+ * @brief Plays the first matching card in sorted order
+ */
+static int chooseFirstMatch(const GameView* view, void* context)
+{
+	(void)context;
+	return handFirstMatch(view -> hand, &view -> currentCard, NULL);
+}
+
+
+/**
+ * @brief Plays into the suit the player holds most of
+ *
+ * A rank match can switch the current suit; switching to the longest
+ * suit leaves the player the most cards that follow. Within that suit the
+ * lowest rank goes first.
+ */
+static int chooseKeepLongestSuit(const GameView* view, void* context)
+{
+	(void)context;
+	int bestSuit = -1;
+
+	for (int s = 0; s < NUM_SUITS; s++) {
+		if (playableRanks(view -> hand, &view -> currentCard, s) != 0
+			&& (bestSuit < 0 || view -> hand -> suitTotals[s] > view -> hand -> suitTotals[bestSuit])) {
+			bestSuit = s;
+		}
+	}
+
+	if (bestSuit < 0) {
+		return STRATEGY_DRAW;
+	}
+	return positionOf(view, bestSuit, lowestRank(playableRanks(view -> hand, &view -> currentCard, bestSuit)));
+}
+
+
+/**
+ * @brief Plays the matching card whose rank the player holds fewest of
+ *
+ * Ranks held several times are what lets a player change suit later, so
+ * the lonely ranks go first.
+ */
+static int chooseDumpRarestRank(const GameView* view, void* context)
+{
+	(void)context;
+	int bestSuit = -1;
+	int bestRank = 0;
+	int bestCount = 0;
+
+	for (int s = 0; s < NUM_SUITS; s++) {
+		uint16_t mask = playableRanks(view -> hand, &view -> currentCard, s);
+		for (int r = 0; mask != 0; r++, mask >>= 1) {
+			if (!(mask & 1u)) {
+				continue;
+			}
+			int count = 0;
+			for (int t = 0; t < NUM_SUITS; t++) {
+				count += view -> hand -> counts[t][r];
+			}
+			if (bestSuit < 0 || count < bestCount) {
+				bestSuit = s;
+				bestRank = r;
+				bestCount = count;
+			}
+		}
+	}
+
+	if (bestSuit < 0) {
+		return STRATEGY_DRAW;
+	}
+	return positionOf(view, bestSuit, bestRank);
+}
+
+
+/**
+ * @brief Plays any matching card, each distinct card equally likely
+ */
+static int chooseRandom(const GameView* view, void* context)
+{
+	(void)context;
+	uint16_t masks[NUM_SUITS];
+	uint32_t total = 0;
+
+	for (int s = 0; s < NUM_SUITS; s++) {
+		masks[s] = playableRanks(view -> hand, &view -> currentCard, s);
+		for (uint16_t m = masks[s]; m != 0; m &= (uint16_t)(m - 1)) {
+			total++;
+		}
+	}
+
+	if (total == 0) {
+		return STRATEGY_DRAW;
+	}
+
+	uint32_t pick = randomBelow(view -> rng, total);
+	for (int s = 0; s < NUM_SUITS; s++) {
+		for (uint16_t m = masks[s]; m != 0; m &= (uint16_t)(m - 1)) {
+			if (pick-- == 0) {
+				return positionOf(view, s, lowestRank(m));
+			}
+		}
+	}
+	return STRATEGY_DRAW;
+}
+
+
+const Strategy firstMatchStrategy = { "firstMatch", chooseFirstMatch, NULL };
+const Strategy keepLongestSuitStrategy = { "keepLongestSuit", chooseKeepLongestSuit, NULL };
+const Strategy dumpRarestRankStrategy = { "dumpRarestRank", chooseDumpRarestRank, NULL };
+const Strategy randomStrategy = { "random", chooseRandom, NULL };
+
+static const Strategy* const builtinStrategies[] = {
+	&firstMatchStrategy,
+	&keepLongestSuitStrategy,
+	&dumpRarestRankStrategy,
+	&randomStrategy
+};
+
+
+/**
+ * @brief Looks up a built-in strategy by name
+ */
+const Strategy* findStrategy(const char* name)
+{
+	for (size_t i = 0; i < sizeof(builtinStrategies) / sizeof(builtinStrategies[0]); i++) {
+		if (strcmp(builtinStrategies[i] -> name, name) == 0) {
+			return builtinStrategies[i];
+		}
+	}
+	return NULL;
+}
+
+
+/**
+ * @brief Number of cards another player holds
+ */
+int viewHandSize(const GameView* view, int player)
+{
+	if (player < 0 || player >= view -> numPlayers) {
+		return 0;
+	}
+	return view -> handSizes[player];
+}
+
+
+/**
+ * @brief Fills a view with what a player can see of a game
+ */
+void initGameView(GameView* view, GameState* game, int playerIndex)
+{
+	Player* player = &game -> players[playerIndex];
+
+	view -> hand = &player -> index;
+	view -> handSize = player -> hand -> size;
+	view -> currentCard = game -> currentCard;
+	view -> player = playerIndex;
+	view -> numPlayers = game -> numPlayers;
+	view -> turn = game -> turns;
+	view -> hiddenSize = hiddenDeckSize(game);
+	view -> playedSize = game -> playedDeck -> size;
+	view -> playedDeck = game -> playedDeck;
+	for (int p = 0; p < game -> numPlayers; p++) {
+		view -> handSizes[p] = game -> players[p].hand -> size;
+	}
+	view -> rng = &game -> strategyRng;
+}
+
+
+/**
+ * @brief Asks the strategy of the player to move which card to play
+ */
+int chooseCardToPlay(GameState* game, int playerIndex)
+{
+	const Strategy* strategy = game -> strategies[playerIndex];
+	Player* player = &game -> players[playerIndex];
+
+	if (!strategy) {
+		return findMatchingCard(game, playerIndex);
+	}
+	if (!handHasMatch(&player -> index, &game -> currentCard)) {
+		return -1;	// the rules say draw, nothing to decide
+	}
+
+	GameView view;
+	initGameView(&view, game, playerIndex);
+
+	int position = strategy -> chooseCard(&view, strategy -> context);
+	const Card* card = peekCardAt(player -> hand, position);
+	if (!card || !isValidMove(card, &game -> currentCard)) {
+		return handFirstMatch(&player -> index, &game -> currentCard, NULL);
+	}
+	return position;
+}
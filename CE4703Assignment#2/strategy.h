@@ -0,0 +1,108 @@
+/**
+ * @file strategy.h
+ * @brief Player strategies: which matching card to play
+ *
+ * The rules decide when a player must draw; a strategy only decides which
+ * card to play when there is a choice. It gets a read-only GameView of
+ * what the player to move can see (their own hand, the current card, the
+ * face-up played deck and the size of every pile) and returns the position in the sorted hand of
+ * the card to play. Views live on the stack and the built-in strategies
+ * only read the hand's HandIndex, so choosing a card allocates nothing.
+ *
+ * @author Oluwatunmise Adegbola
+ * @date 17 October 2026
+*/
+
+#ifndef STRATEGY_H
+#define STRATEGY_H
+
+#include "game.h"
+#include "rng.h"
+
+#define STRATEGY_DRAW -1	// nothing to play; only legal when no card matches
+
+/**
+  * @brief What the player to move can see of the game
+*/
+typedef struct GameView {
+	const HandIndex* hand;	// the player's cards by suit and rank, in sorted order
+	int handSize;	// number of cards held
+	Card currentCard;	// card to match
+	int player;	// seat of the player to move
+	int numPlayers;	// players at the table
+	int turn;	// turn number, 1 for the first turn
+	int hiddenSize;	// cards left in the hidden deck
+	int playedSize;	// cards in the played deck
+	const CardDeck* playedDeck;	// the face-up played deck, current card on top
+	int handSizes[MAX_PLAYERS];	// cards held by each player (numPlayers entries)
+	Rng* rng;	// random stream for strategies that need one
+} GameView;
+
+/**
+  * @brief Picks the card to play
+  *
+  * @param view What the player can see, valid only during the call
+  * @param context The strategy's own data
+  * @return Position in the sorted hand of a card matching the current
+  *         card, or STRATEGY_DRAW
+*/
+typedef int (*ChooseCardFn)(const GameView* view, void* context);
+
+/**
+  * @brief A named strategy
+*/
+typedef struct Strategy {
+	const char* name;	// short name, used on the command line
+	ChooseCardFn chooseCard;	// decision function
+	void* context;	// passed to chooseCard
+} Strategy;
+
+/* --- built-in strategies --- */
+extern const Strategy firstMatchStrategy;	// first match in sorted order, the classic rule
+extern const Strategy keepLongestSuitStrategy;	// steer the current suit to the suit held most
+extern const Strategy dumpRarestRankStrategy;	// play the rank held fewest copies of
+extern const Strategy randomStrategy;	// any matching card, uniformly
+
+/**
+  * @brief Looks up a built-in strategy by name.
+  *
+  * @param name Strategy name, e.g. "firstMatch"
+  * @return The strategy, or NULL if there is none with that name
+*/
+const Strategy* findStrategy(const char* name);
+
+/**
+  * @brief Number of cards another player holds.
+  *
+  * @param view View passed to the strategy
+  * @param player Seat, 0 to numPlayers-1
+  * @return Cards in that player's hand
+*/
+int viewHandSize(const GameView* view, int player);
+
+/**
+  * @brief Fills a view with what a player can see of a game.
+  *
+  * The view points into game, so it is only valid until the game changes.
+  *
+  * @param view View to fill, cannot be NULL
+  * @param game Game state, the player's hand must be sorted
+  * @param playerIndex Player whose view it is
+*/
+void initGameView(GameView* view, GameState* game, int playerIndex);
+
+/**
+  * @brief Asks the strategy of the player to move which card to play.
+  *
+  * Players without a strategy use findMatchingCard() directly. If nothing
+  * can be played the strategy is not asked. A choice that is not a
+  * playable card falls back to the first match, so a faulty strategy can
+  * never break the rules.
+  *
+  * @param game Game state, the player's hand must be sorted
+  * @param playerIndex Player to move
+  * @return Position of the card to play, or -1 if the player must draw
+*/
+int chooseCardToPlay(GameState* game, int playerIndex);
+
+#endif // !STRATEGY_H
@@ -0,0 +1,107 @@
+/**
+ * @file virtualDeck.c
+ * @brief Implementation of the card-count draw pile
+ *
+ * @author Shrestha Dey
+ * @date 17 October 2026
+ */
+#include "virtualDeck.h"
+#include <string.h>
+
+/**
+ * @brief Fills a virtual deck with complete packs
+ */
+void initVirtualDeck(VirtualDeck* deck, int num_packs, uint64_t seed)
+{
+    for (int i = 0; i < NUM_CARD_TYPES; i++) {
+        deck->counts[i] = num_packs;
+    }
+    deck->size = num_packs * NUM_CARD_TYPES;
+    seedRng(&deck->rng, seed);
+}
+
+/**
+ * @brief Removes a uniformly random card from the deck
+ *
+ * Picks the position of the card among the remaining ones and walks the
+ * counts to find its type, so each card, not each type, is equally likely.
+ */
+bool drawVirtualCard(VirtualDeck* deck, Card* out_card)
+{
+    if (deck->size <= 0) {
+        return false;
+    }
+
+    int position = (int)randomBelow(&deck->rng, (uint32_t)deck->size);
+    int type = 0;
+    while (position >= deck->counts[type]) {
+        position -= deck->counts[type];
+        type++;
+    }
+
+    deck->counts[type]--;
+    deck->size--;
+    *out_card = unpackCard((PackedCard)type);
+    return true;
+}
+
+/**
+ * @brief Adds a card to the deck
+ */
+bool addVirtualCard(VirtualDeck* deck, Card card)
+{
+    if (!isValidCard(card)) return false;  /// would index outside counts
+    deck->counts[packCard(card)]++;
+    deck->size++;
+    return true;
+}
+
+/**
+ * @brief Moves all but the top keep cards of a deck into a virtual deck
+ *
+ * Each card below the kept ones is taken from position keep, which is
+ * O(1) with both CardDeck backends.
+ */
+int moveIntoVirtualDeck(CardDeck* src, int keep, VirtualDeck* dest)
+{
+    int moved = 0;
+    Card card;
+    while (src->size > keep) {
+        const Card* next = peekCardAt(src, keep);
+        if (next == NULL) break;
+        if (!isValidCard(*next)) {
+            keep++;  /// leave cards the virtual deck cannot count in src
+            continue;
+        }
+        if (!removeCardAt(src, keep, &card)) break;
+        addVirtualCard(dest, card);
+        moved++;
+    }
+    return moved;
+}
+
+/**
+ * @brief Copies the deck's cards into a packed array, in card type order
+ */
+int packVirtualDeck(const VirtualDeck* deck, PackedCard* out)
+{
+    int written = 0;
+    for (int type = 0; type < NUM_CARD_TYPES; type++) {
+        for (int n = deck->counts[type]; n > 0; n--) {
+            out[written++] = (PackedCard)type;
+        }
+    }
+    return written;
+}
+
+/**
+ * @brief Replaces the deck's cards with packed cards
+ */
+void loadVirtualDeck(VirtualDeck* deck, const PackedCard* cards, int count)
+{
+    memset(deck->counts, 0, sizeof(deck->counts));
+    for (int i = 0; i < count; i++) {
+        deck->counts[cards[i]]++;
+    }
+    deck->size = count;
+}
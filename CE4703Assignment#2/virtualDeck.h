@@ -0,0 +1,100 @@
+/**
+ * @file virtualDeck.h
+ * @brief Shuffled draw pile kept as card counts instead of cards
+ *
+ * A VirtualDeck only remembers how many cards of each of the 52 types it
+ * holds. Creating one for any number of packs is O(1) and it never
+ * allocates, whatever its size. There is no order to shuffle: every draw
+ * picks one of the remaining cards uniformly at random, which gives each
+ * sequence of draws the same probability as drawing from the top of a
+ * Fisher-Yates shuffled CardDeck. Only the random numbers differ, so a
+ * seed does not deal the same game in both kinds of deck.
+ *
+ * The game uses it for the hidden deck when GameConfig::lazyHiddenDeck is
+ * set, see hiddenDeckSize().
+ *
+ * @author Shrestha Dey
+ * @date 17 October 2026
+ */
+
+#pragma once
+#ifndef VIRTUALDECK_H
+#define VIRTUALDECK_H
+
+#include "card.h"
+#include "deck.h"
+#include "rng.h"
+#include <stdbool.h>
+
+/**
+ * @brief Draw pile stored as the number of cards left of each type
+ */
+typedef struct {
+    int counts[NUM_CARD_TYPES];  ///< Cards left of each type, by PackedCard
+    int size;                    ///< Cards left in total
+    Rng rng;                     ///< Random stream used by drawVirtualCard()
+} VirtualDeck;
+
+/**
+ * @brief Fills a virtual deck with complete packs
+ *
+ * @param deck Deck to fill, cannot be NULL
+ * @param num_packs Number of complete card packs (>= 0)
+ * @param seed Seed for the deck's random stream
+ */
+void initVirtualDeck(VirtualDeck* deck, int num_packs, uint64_t seed);
+
+/**
+ * @brief Removes a uniformly random card from the deck
+ *
+ * @param deck Deck to draw from, cannot be NULL
+ * @param out_card Pointer to store the drawn card, cannot be NULL
+ * @return true if a card was drawn, false if the deck was empty
+ */
+bool drawVirtualCard(VirtualDeck* deck, Card* out_card);
+
+/**
+ * @brief Adds a card to the deck
+ *
+ * @param deck Deck to add to, cannot be NULL
+ * @param card Card to add
+ * @return false if card has an out of range suit or rank, the deck is
+ *         then unchanged
+ */
+bool addVirtualCard(VirtualDeck* deck, Card card);
+
+/**
+ * @brief Moves all but the top keep cards of a deck into a virtual deck
+ *
+ * The virtual deck counts as shuffled afterwards, so unlike
+ * moveAllButTop() followed by shuffleDeck() this needs no pass over the
+ * cards in random order. Cards with an out of range suit or rank stay in
+ * src, below the kept ones.
+ *
+ * @param src Deck to take the cards from, cannot be NULL
+ * @param keep Number of cards that stay on top of src (>= 0)
+ * @param dest Virtual deck receiving the cards, cannot be NULL
+ * @return Number of cards moved
+ */
+int moveIntoVirtualDeck(CardDeck* src, int keep, VirtualDeck* dest);
+
+/**
+ * @brief Copies the deck's cards into a packed array, in card type order
+ *
+ * @param deck Deck to read, cannot be NULL
+ * @param out Array of at least deck->size packed cards
+ * @return Number of cards written
+ */
+int packVirtualDeck(const VirtualDeck* deck, PackedCard* out);
+
+/**
+ * @brief Replaces the deck's cards with packed cards, its random stream
+ * is left alone
+ *
+ * @param deck Deck to fill, cannot be NULL
+ * @param cards Packed cards, each 0-51
+ * @param count Number of cards
+ */
+void loadVirtualDeck(VirtualDeck* deck, const PackedCard* cards, int count);
+
+#endif // !VIRTUALDECK_H
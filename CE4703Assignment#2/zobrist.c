@@ -0,0 +1,254 @@
+/**
+ * @file zobrist.c
+ * @brief Position hashing and the transposition table
+ *
+ * @author Oluwatunmise Adegbola
+ * @date 17 October 2026
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <malloc.h>
+#include <windows.h>
+#endif
+
+#include "zobrist.h"
+
+#define TT_ALIGNMENT 64	// bytes in a bucket, so each one starts a cache line
+
+/**
+ * @brief One entry: check is hash ^ value, 0/0 when empty
+ *
+ * Threads share entries without locks, so the words are only read and
+ * written through loadWord() and storeWord().
+ */
+typedef struct TTEntry {
+	uint64_t check;
+	uint64_t value;
+} TTEntry;
+
+struct TranspositionTable {
+	TTEntry* entries;	// buckets of TT_BUCKET_SIZE entries
+	size_t mask;	// number of buckets - 1
+};
+
+
+/**
+ * @brief Helper function to read a table word another thread may write
+ *
+ * A relaxed atomic load: the word is never torn, and the entry's check
+ * catches a value and check from different stores.
+ *
+ * @param word Word to read
+ * @return Its value
+ */
+static uint64_t loadWord(const uint64_t* word)
+{
+#ifdef _WIN32
+	return (uint64_t)ReadNoFence64((const volatile LONG64*)word);
+#else
+	return __atomic_load_n(word, __ATOMIC_RELAXED);
+#endif
+}
+
+
+/**
+ * @brief Helper function to write a table word other threads may read
+ *
+ * @param word Word to write
+ * @param value Value to store
+ */
+static void storeWord(uint64_t* word, uint64_t value)
+{
+#ifdef _WIN32
+	WriteNoFence64((volatile LONG64*)word, (LONG64)value);
+#else
+	__atomic_store_n(word, value, __ATOMIC_RELAXED);
+#endif
+}
+
+
+/**
+ * @brief Sum of the card keys of one deck
+ */
+static uint64_t sumDeck(const CardDeck* deck)
+{
+	uint64_t sum = 0;
+	DeckIterator it = deckBegin(deck);
+	const Card* card;
+	while ((card = deckNext(&it)) != NULL) {
+		sum += zobristCardKey(*card);
+	}
+	return sum;
+}
+
+
+/**
+ * @brief Sum of the card keys of a virtual deck
+ */
+static uint64_t sumVirtualDeck(const VirtualDeck* deck)
+{
+	uint64_t sum = 0;
+	for (int type = 0; type < NUM_CARD_TYPES; type++) {
+		sum += zobristCardKey(unpackCard((PackedCard)type)) * (uint64_t)deck -> counts[type];
+	}
+	return sum;
+}
+
+
+/**
+ * @brief Hashes a game from scratch
+ */
+uint64_t rehashGame(GameState* game)
+{
+	memset(game -> pileSums, 0, sizeof(game -> pileSums));
+	game -> pileSums[ZOBRIST_HIDDEN] = game -> lazyHiddenDeck
+		? sumVirtualDeck(&game -> virtualHidden) : sumDeck(game -> hiddenDeck);
+	game -> pileSums[ZOBRIST_PLAYED] = sumDeck(game -> playedDeck);
+	for (int p = 0; p < game -> numPlayers; p++) {
+		game -> pileSums[ZOBRIST_HAND(p)] = sumDeck(game -> players[p].hand);
+	}
+
+	uint64_t hash = zobristCurrentKey(game -> currentCard) + zobristPlayerKey(game -> currentPlayer);
+	for (int pile = 0; pile < ZOBRIST_HAND(game -> numPlayers); pile++) {
+		hash += zobristPileKey(pile) * game -> pileSums[pile];
+	}
+	game -> hash = hash;
+	return hash;
+}
+
+
+/**
+ * @brief Adds a position to a short history and counts its repeats
+ */
+int recordPosition(uint64_t* history, int count, uint64_t hash)
+{
+	int stored = count < CYCLE_HISTORY ? count : CYCLE_HISTORY;
+	int repeats = 1;
+
+	for (int i = 0; i < stored; i++) {
+		repeats += history[i] == hash;
+	}
+	history[count % CYCLE_HISTORY] = hash;
+	return repeats;
+}
+
+
+/**
+ * @brief Creates an empty table
+ */
+TranspositionTable* createTranspositionTable(size_t entries)
+{
+	size_t buckets = 1;
+	while (buckets * 2 * TT_BUCKET_SIZE <= entries) {
+		buckets *= 2;
+	}
+
+	TranspositionTable* table = malloc(sizeof(TranspositionTable));
+	if (!table) {
+		return NULL;
+	}
+	// the size is a whole number of buckets, so of TT_ALIGNMENT bytes
+	size_t bytes = buckets * TT_BUCKET_SIZE * sizeof(TTEntry);
+#ifdef _WIN32
+	table -> entries = _aligned_malloc(bytes, TT_ALIGNMENT);
+#else
+	table -> entries = aligned_alloc(TT_ALIGNMENT, bytes);
+#endif
+	if (!table -> entries) {
+		free(table);
+		return NULL;
+	}
+	table -> mask = buckets - 1;
+	clearTranspositionTable(table);
+	return table;
+}
+
+
+/**
+ * @brief Frees a table
+ */
+void freeTranspositionTable(TranspositionTable* table)
+{
+	if (table) {
+#ifdef _WIN32
+		_aligned_free(table -> entries);
+#else
+		free(table -> entries);
+#endif
+		free(table);
+	}
+}
+
+
+/**
+ * @brief Empties a table
+ */
+void clearTranspositionTable(TranspositionTable* table)
+{
+	memset(table -> entries, 0, (table -> mask + 1) * TT_BUCKET_SIZE * sizeof(TTEntry));
+}
+
+
+/**
+ * @brief Looks a position up
+ */
+bool probeTransposition(const TranspositionTable* table, uint64_t hash, uint64_t* value)
+{
+	const TTEntry* bucket = &table -> entries[(hash & table -> mask) * TT_BUCKET_SIZE];
+
+	for (int i = 0; i < TT_BUCKET_SIZE; i++) {
+		uint64_t check = loadWord(&bucket[i].check);
+		uint64_t stored = loadWord(&bucket[i].value);
+		if ((check ^ stored) == hash && (check | stored) != 0) {
+			*value = stored;
+			return true;
+		}
+	}
+	return false;
+}
+
+
+/**
+ * @brief Stores a value for a position
+ */
+void storeTransposition(TranspositionTable* table, uint64_t hash, uint64_t value)
+{
+	TTEntry* bucket = &table -> entries[(hash & table -> mask) * TT_BUCKET_SIZE];
+	int slot = -1;
+
+	uint64_t check[TT_BUCKET_SIZE];
+	uint64_t stored[TT_BUCKET_SIZE];
+	for (int i = 0; i < TT_BUCKET_SIZE; i++) {
+		check[i] = loadWord(&bucket[i].check);
+		stored[i] = loadWord(&bucket[i].value);
+	}
+
+	for (int i = 0; i < TT_BUCKET_SIZE && slot < 0; i++) {
+		if ((check[i] ^ stored[i]) == hash) {
+			slot = i;
+		}
+	}
+	for (int i = 0; i < TT_BUCKET_SIZE && slot < 0; i++) {
+		if ((check[i] | stored[i]) == 0) {
+			slot = i;
+		}
+	}
+	if (slot < 0) {
+		slot = (int)(hash >> 62);	// the bucket index used the low bits
+	}
+
+	storeWord(&bucket[slot].value, value);
+	storeWord(&bucket[slot].check, hash ^ value);
+}
+
+
+/**
+ * @brief Number of entries of a table
+ */
+size_t transpositionTableSize(const TranspositionTable* table)
+{
+	return (table -> mask + 1) * TT_BUCKET_SIZE;
+}
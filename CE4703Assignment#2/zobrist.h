@@ -0,0 +1,198 @@
+/**
+ * @file zobrist.h
+ * @brief Zobrist hashing of game positions and a transposition table
+ *
+ * A position is hashed from the current card, the player to move and
+ * the cards in every pile. Piles hold several copies of a card once more
+ * than one pack is used, so a pile is hashed as a multiset with additive
+ * keys: the sum over its cards of key(card) is kept per pile, and the
+ * position hash adds each pile's sum times an odd per-pile multiplier.
+ * Adding or removing a card is then one addition, whatever the number of
+ * copies, and moving the whole played deck but its top card to the
+ * hidden deck (a reshuffle) is one multiplication: the moved cards'
+ * hidden sum is their played sum. The order of the hidden deck is not
+ * part of the hash, only its contents.
+ *
+ * The keys are a fixed mix of their index, so hashes are the same in
+ * every run and on every thread, with no table to set up.
+ *
+ * The transposition table maps hashes to one 64-bit value each. It is a
+ * fixed array of 4-entry buckets, each 64 bytes and allocated on a
+ * 64-byte boundary so it fills one cache line. An entry is stored as
+ * (hash ^ value, value), each word read and written with relaxed atomic
+ * operations, so a reader racing with a writer sees a torn entry as a
+ * miss instead of a wrong value: threads can share a table without
+ * locks. Clearing the table is not one of the shared operations.
+ *
+ * @author Oluwatunmise Adegbola
+ * @date 17 October 2026
+*/
+
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "game.h"
+
+#define ZOBRIST_HIDDEN 0	// pile index of the hidden deck
+#define ZOBRIST_PLAYED 1	// pile index of the played deck
+#define ZOBRIST_HAND(p) (2 + (p))	// pile index of player p's hand
+#define TT_BUCKET_SIZE 4	// entries per bucket
+
+/**
+  * @brief SplitMix64 finaliser, turns an index into a well mixed key
+*/
+static inline uint64_t zobristMix(uint64_t x)
+{
+	x += 0x9E3779B97F4A7C15ULL;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+	return x ^ (x >> 31);
+}
+
+/**
+  * @brief Key of a card in a pile, before the pile's multiplier
+*/
+static inline uint64_t zobristCardKey(Card card)
+{
+	return zobristMix(packCard(card));
+}
+
+/**
+  * @brief Odd multiplier of a pile
+*/
+static inline uint64_t zobristPileKey(int pile)
+{
+	return zobristMix(0x100 + (uint64_t)pile) | 1;
+}
+
+/**
+  * @brief Key of the card on the table
+*/
+static inline uint64_t zobristCurrentKey(Card card)
+{
+	return zobristMix(0x200 + (uint64_t)packCard(card));
+}
+
+/**
+  * @brief Key of the player to move
+*/
+static inline uint64_t zobristPlayerKey(int player)
+{
+	return zobristMix(0x300 + (uint64_t)player);
+}
+
+/**
+  * @brief Adds a card to a pile's hash
+  *
+  * @param game Game whose hash to update
+  * @param pile ZOBRIST_HIDDEN, ZOBRIST_PLAYED or ZOBRIST_HAND(p)
+  * @param card Card that joined the pile
+*/
+static inline void zobristAddCard(GameState* game, int pile, Card card)
+{
+	uint64_t key = zobristCardKey(card);
+	game -> pileSums[pile] += key;
+	game -> hash += zobristPileKey(pile) * key;
+}
+
+/**
+  * @brief Removes a card from a pile's hash
+  *
+  * @param game Game whose hash to update
+  * @param pile ZOBRIST_HIDDEN, ZOBRIST_PLAYED or ZOBRIST_HAND(p)
+  * @param card Card that left the pile
+*/
+static inline void zobristRemoveCard(GameState* game, int pile, Card card)
+{
+	uint64_t key = zobristCardKey(card);
+	game -> pileSums[pile] -= key;
+	game -> hash -= zobristPileKey(pile) * key;
+}
+
+/**
+  * @brief Hashes a game from scratch
+  *
+  * Sets game->pileSums and returns the hash; used after the deal and after
+  * a position is restored, and to check the incremental updates.
+  *
+  * @param game Game to hash, cards must have been dealt
+  * @return Hash of the position
+*/
+uint64_t rehashGame(GameState* game);
+
+/**
+  * @brief Adds a position to a short history and counts its repeats
+  *
+  * The history is a ring of CYCLE_HISTORY hashes; only the last
+  * CYCLE_HISTORY positions are compared.
+  *
+  * @param history Ring of hashes, cannot be NULL
+  * @param count Positions added to the ring before this one
+  * @param hash Hash of the position
+  * @return Times the position is in the history, this one included
+*/
+int recordPosition(uint64_t* history, int count, uint64_t hash);
+
+/**
+  * @brief Fixed-size hash table of positions, see the file comment
+*/
+typedef struct TranspositionTable TranspositionTable;
+
+/**
+  * @brief Creates an empty table
+  *
+  * @param entries Number of entries, rounded down to a power of two
+  *        buckets (at least one)
+  * @return New table, or NULL on memory failure
+*/
+TranspositionTable* createTranspositionTable(size_t entries);
+
+/**
+  * @brief Frees a table
+  *
+  * @param table Table to free, may be NULL
+*/
+void freeTranspositionTable(TranspositionTable* table);
+
+/**
+  * @brief Empties a table, not safe while other threads use it
+  *
+  * @param table Table to clear, cannot be NULL
+*/
+void clearTranspositionTable(TranspositionTable* table);
+
+/**
+  * @brief Looks a position up
+  *
+  * @param table Table to search, cannot be NULL
+  * @param hash Hash of the position
+  * @param value Where to store the value, cannot be NULL
+  * @return true if the position was found
+*/
+bool probeTransposition(const TranspositionTable* table, uint64_t hash, uint64_t* value);
+
+/**
+  * @brief Stores a value for a position
+  *
+  * Overwrites the position's entry if it is in the bucket, otherwise an
+  * empty entry, otherwise an entry picked by the hash.
+  *
+  * @param table Table to update, cannot be NULL
+  * @param hash Hash of the position
+  * @param value Value to store
+*/
+void storeTransposition(TranspositionTable* table, uint64_t hash, uint64_t value);
+
+/**
+  * @brief Number of entries of a table
+  *
+  * @param table Table, cannot be NULL
+  * @return Capacity in entries
+*/
+size_t transpositionTableSize(const TranspositionTable* table);
+
+#endif // !ZOBRIST_H
@@ -0,0 +1,649 @@
+/**
+ * @file benchmark.c
+ * @brief Microbenchmarks for the deck, sort, shuffle and full games
+ *
+ * Every benchmark is run a few times untimed to warm up caches and node
+ * pools, then repeated and timed. Each repetition produces one sample in
+ * nanoseconds per operation; the minimum, median and mean are printed as
+ * one CSV line per benchmark so that runs from different revisions (or
+ * the two deck backends) can be diffed and plotted.
+ *
+ * Output columns:
+ *   benchmark,param,backend,reps,ops_per_rep,min_ns,median_ns,mean_ns
+ *
+ * Usage: cardgame_bench [--quick] [--filter NAME[,NAME...]]
+ *
+ * @author Shrestha Dey
+ * @date 17 October 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "batchSimulation.h"
+#include "deck.h"
+#include "game.h"
+#include "gameSimulation.h"
+#include "gameSnapshot.h"
+#include "mcts.h"
+#include "nodePool.h"
+#include "sort.h"
+#include "zobrist.h"
+
+#define MAX_REPS 64
+#define DRAWS_PER_GAME 16  // about the cards drawn in a one-pack game
+
+#if DECK_RING_BUFFER
+#define BACKEND_NAME "ring"
+#else
+#define BACKEND_NAME "list"
+#endif
+
+static int warmupReps = 3;
+static int timedReps = 15;
+static const char* filter = NULL;  // comma-separated benchmark names, NULL runs them all
+
+/**
+ * @brief Returns a monotonic timestamp in nanoseconds
+ */
+static double nowNs(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart * 1e9 / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+/**
+ * @brief qsort comparison for doubles
+ */
+static int compareDoubles(const void* a, const void* b)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Checks whether a comma-separated list holds a name
+ *
+ * @param list Comma-separated names
+ * @param name Name to look for, need not be terminated
+ * @param length Length of name
+ */
+static int listHasName(const char* list, const char* name, size_t length)
+{
+    while (*list) {
+        size_t entry = strcspn(list, ",");
+        if (entry == length && strncmp(list, name, length) == 0) {
+            return 1;
+        }
+        list += entry;
+        if (*list == ',') {
+            list++;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Checks the names a benchmark reports against --filter
+ *
+ * The benchmark runs when one of its comma-separated names is exactly
+ * one of the names in the filter.
+ */
+static int selected(const char* names)
+{
+    if (filter == NULL) {
+        return 1;
+    }
+    while (*names) {
+        size_t length = strcspn(names, ",");
+        if (listHasName(filter, names, length)) {
+            return 1;
+        }
+        names += length;
+        if (*names == ',') {
+            names++;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Prints one CSV result line
+ *
+ * @param name Benchmark name
+ * @param param Size parameter (packs, position, ...)
+ * @param samples Nanoseconds per operation of each timed repetition
+ * @param reps Number of samples
+ * @param opsPerRep Operations timed in each repetition
+ */
+static void report(const char* name, long param, double* samples, int reps, long opsPerRep)
+{
+    double sum = 0.0;
+    for (int i = 0; i < reps; i++) {
+        sum += samples[i];
+    }
+    qsort(samples, (size_t)reps, sizeof(double), compareDoubles);
+
+    printf("%s,%ld,%s,%d,%ld,%.1f,%.1f,%.1f\n", name, param, BACKEND_NAME, reps, opsPerRep,
+        samples[0], samples[reps / 2], sum / reps);
+    fflush(stdout);
+}
+
+/**
+ * @brief initDeck + freeDeck for a number of packs
+ */
+static void benchInitDeck(int packs)
+{
+    double samples[MAX_REPS];
+    long ops = packs >= 100 ? 10 : 200;
+
+    for (int rep = -warmupReps; rep < timedReps; rep++) {
+        double start = nowNs();
+        for (long i = 0; i < ops; i++) {
+            freeDeck(initDeckSeeded(packs, (uint64_t)i));
+        }
+        double elapsed = nowNs() - start;
+        if (rep >= 0) {
+            samples[rep] = elapsed / ops;
+        }
+    }
+    report("initDeck", packs, samples, timedReps, ops);
+}
+
+/**
+ * @brief shuffleDeck on a pooled deck of a number of packs
+ */
+static void benchShuffle(int packs)
+{
+    double samples[MAX_REPS];
+    long ops = packs >= 100 ? 5 : 100;
+    NodePool* pool = createNodePool(0);
+    CardDeck* deck = initDeckWithPool(packs, 1, pool);
+
+    for (int rep = -warmupReps; rep < timedReps; rep++) {
+        double start = nowNs();
+        for (long i = 0; i < ops; i++) {
+            shuffleDeck(deck);
+        }
+        double elapsed = nowNs() - start;
+        if (rep >= 0) {
+            samples[rep] = elapsed / ops;
+        }
+    }
+    report("shuffleDeck", packs, samples, timedReps, ops);
+
+    freeDeck(deck);
+    freeNodePool(pool);
+}
+
+/**
+ * @brief A shuffle followed by the draws of a typical game
+ *
+ * Shuffles with shuffleDeck() or shuffleDeckLazy(), draws DRAWS_PER_GAME
+ * cards and puts them back at the bottom. A lazy shuffle only pays for
+ * the drawn cards with the ring buffer backend.
+ */
+static void benchShuffleDraw(const char* name, bool lazy, int packs)
+{
+    double samples[MAX_REPS];
+    long ops = packs >= 100 ? 5 : 100;
+    NodePool* pool = createNodePool(0);
+    CardDeck* deck = initDeckWithPool(packs, 1, pool);
+
+    for (int rep = -warmupReps; rep < timedReps; rep++) {
+        double start = nowNs();
+        for (long i = 0; i < ops; i++) {
+            if (lazy) {
+                shuffleDeckLazy(deck);
+            }
+            else {
+                shuffleDeck(deck);
+            }
+            for (int d = 0; d < DRAWS_PER_GAME; d++) {
+                Card card;
+                removeTopCard(deck, &card);
+                addCardToEnd(deck, card);
+            }
+        }
+        double elapsed = nowNs() - start;
+        if (rep >= 0) {
+            samples[rep] = elapsed / ops;
+        }
+    }
+    report(name, packs, samples, timedReps, ops);
+
+    freeDeck(deck);
+    freeNodePool(pool);
+}
+
+/**
+ * @brief Sorts a freshly shuffled deck with one of the sort functions
+ *
+ * Only the sort is timed, the shuffle before each sort is not.
+ */
+static void benchSort(const char* name, void (*sort)(CardDeck*), int packs)
+{
+    double samples[MAX_REPS];
+    long ops = packs >= 100 ? 3 : 50;
+    CardDeck* deck = initDeckSeeded(packs, 2);
+
+    for (int rep = -warmupReps; rep < timedReps; rep++) {
+        double elapsed = 0.0;
+        for (long i = 0; i < ops; i++) {
+            shuffleDeck(deck);
+            double start = nowNs();
+            sort(deck);
+            elapsed += nowNs() - start;
+        }
+        if (rep >= 0) {
+            samples[rep] = elapsed / ops;
+        }
+    }
+    report(name, packs, samples, timedReps, ops);
+
+    freeDeck(deck);
+}
+
+static void sortWithCompareCards(CardDeck* deck)
+{
+    sortDeckWith(deck, compareCards);
+}
+
+/**
+ * @brief removeCardAt at a relative position, card put back at the bottom
+ *
+ * @param packs Deck size in packs
+ * @param percent Position as a percentage of the deck size (0 = top)
+ */
+static void benchRemoveAt(int packs, int percent)
+{
+    double samples[MAX_REPS];
+    long ops = 1000;
+    NodePool* pool = createNodePool(0);
+    CardDeck* deck = initDeckWithPool(packs, 3, pool);
+    int position = (int)((long)(deck->size - 1) * percent / 100);
+    char name[64];
+    snprintf(name, sizeof(name), "removeCardAt_%dpct", percent);
+
+    for (int rep = -warmupReps; rep < timedReps; rep++) {
+        double start = nowNs();
+        for (long i = 0; i < ops; i++) {
+            Card card;
+            removeCardAt(deck, position, &card);
+            addCardToEnd(deck, card);
+        }
+        double elapsed = nowNs() - start;
+        if (rep >= 0) {
+            samples[rep] = elapsed / ops;
+        }
+    }
+    report(name, packs, samples, timedReps, ops);
+
+    freeDeck(deck);
+    freeNodePool(pool);
+}
+
+/**
+ * @brief Adds cards to a sorted deck, either in place or by append + sort
+ *
+ * insertCardSorted is what a draw costs now; appendAndSort is the old
+ * addCardToEnd followed by a full sortDeck. The deck is rebuilt (not
+ * timed) before each rep.
+ */
+static void benchSortedInsert(const char* name, bool insert, int packs)
+{
+    double samples[MAX_REPS];
+    long ops = packs >= 100 ? 20 : 200;
+    CardDeck* cards = initDeckSeeded(1, 5);
+    shuffleDeck(cards);
+
+    for (int rep = -warmupReps; rep < timedReps; rep++) {
+        CardDeck* deck = initDeckSeeded(packs, 6);
+        sortDeck(deck);
+        double start = nowNs();
+        for (long i = 0; i < ops; i++) {
+            Card card = *peekCardAt(cards, (int)(i % CARDS_PER_PACK));
+            if (insert) {
+                insertCardSorted(deck, card);
+            }
+            else {
+                addCardToEnd(deck, card);
+                sortDeck(deck);
+            }
+        }
+        double elapsed = nowNs() - start;
+        if (rep >= 0) {
+            samples[rep] = elapsed / ops;
+        }
+        freeDeck(deck);
+    }
+    report(name, packs, samples, timedReps, ops);
+
+    freeDeck(cards);
+}
+
+/**
+ * @brief reshuffleHiddenDeck with every card on the played deck
+ *
+ * Before each timed call all the cards are moved back from the hidden
+ * deck to the played deck (not timed).
+ */
+static void benchReshuffle(int packs)
+{
+    double samples[MAX_REPS];
+    long ops = packs >= 100 ? 5 : 50;
+    GameState* game = initGameSeeded(packs, 4);
+
+    for (int rep = -warmupReps; rep < timedReps; rep++) {
+        double elapsed = 0.0;
+        for (long i = 0; i < ops; i++) {
+            moveAllButTop(game->hiddenDeck, 0, game->playedDeck);
+            double start = nowNs();
+            reshuffleHiddenDeck(game);
+            elapsed += nowNs() - start;
+        }
+        if (rep >= 0) {
+            samples[rep] = elapsed / ops;
+        }
+    }
+    report("reshuffleHiddenDeck", packs, samples, timedReps, ops);
+
+    freeGame(game);
+}
+
+/**
+ * @brief Snapshot, restore and clone of a dealt game
+ *
+ * copyGameSnapshot is the memcpy clone search code repeats; snapshotGame
+ * and restoreGame convert to and from the linked-list GameState.
+ */
+static void benchSnapshot(int packs)
+{
+    double samples[3][MAX_REPS];
+    long ops = packs >= 100 ? 100 : 10000;
+    GameState* game = initGameSeeded(packs, 7);
+    dealInitialCards(game);
+    GameSnapshot* snapshot = createGameSnapshot(packs, game->numPlayers);
+    GameSnapshot* copy = createGameSnapshot(packs, game->numPlayers);
+    snapshotGame(game, snapshot);
+
+    for (int rep = -warmupReps; rep < timedReps; rep++) {
+        double start = nowNs();
+        for (long i = 0; i < ops; i++) {
+            snapshotGame(game, snapshot);
+        }
+        double snapped = nowNs();
+        for (long i = 0; i < ops; i++) {
+            restoreGame(game, snapshot);
+        }
+        double restored = nowNs();
+        for (long i = 0; i < ops; i++) {
+            copyGameSnapshot(copy, snapshot);
+        }
+        double copied = nowNs();
+        if (rep >= 0) {
+            samples[0][rep] = (snapped - start) / ops;
+            samples[1][rep] = (restored - snapped) / ops;
+            samples[2][rep] = (copied - restored) / ops;
+        }
+    }
+    report("snapshotGame", packs, samples[0], timedReps, ops);
+    report("restoreGame", packs, samples[1], timedReps, ops);
+    report("copyGameSnapshot", packs, samples[2], timedReps, ops);
+
+    freeGameSnapshot(copy);
+    freeGameSnapshot(snapshot);
+    freeGame(game);
+}
+
+/**
+ * @brief Hashing a dealt game from scratch
+ *
+ * The cost the incremental updates in playCard, drawCardForPlayer and
+ * reshuffleHiddenDeck avoid; it grows with the number of cards.
+ */
+static void benchRehash(int packs)
+{
+    double samples[MAX_REPS];
+    long ops = packs >= 100 ? 100 : 10000;
+    GameState* game = initGameSeeded(packs, 7);
+    dealInitialCards(game);
+
+    for (int rep = -warmupReps; rep < timedReps; rep++) {
+        double start = nowNs();
+        for (long i = 0; i < ops; i++) {
+            rehashGame(game);
+        }
+        double elapsed = nowNs() - start;
+        if (rep >= 0) {
+            samples[rep] = elapsed / ops;
+        }
+    }
+    report("rehashGame", packs, samples, timedReps, ops);
+
+    freeGame(game);
+}
+
+/**
+ * @brief Stores then probes of random hashes in a transposition table
+ *
+ * param is the table size in entries; the larger tables no longer fit in
+ * the caches, so the probes measure memory latency.
+ */
+static void benchTransposition(long entries)
+{
+    double samples[2][MAX_REPS];
+    long ops = 100000;
+    TranspositionTable* table = createTranspositionTable((size_t)entries);
+    uint64_t found = 0;
+
+    for (int rep = -warmupReps; rep < timedReps; rep++) {
+        uint64_t key = (uint64_t)rep;
+        double start = nowNs();
+        for (long i = 0; i < ops; i++) {
+            storeTransposition(table, zobristMix(key + (uint64_t)i), (uint64_t)i);
+        }
+        double stored = nowNs();
+        for (long i = 0; i < ops; i++) {
+            uint64_t value;
+            found += probeTransposition(table, zobristMix(key + (uint64_t)i), &value);
+        }
+        double probed = nowNs();
+        if (rep >= 0) {
+            samples[0][rep] = (stored - start) / ops;
+            samples[1][rep] = (probed - stored) / ops;
+        }
+    }
+    report("storeTransposition", entries, samples[0], timedReps, ops);
+    report("probeTransposition", entries, samples[1], timedReps, ops);
+
+    if (found == 0) {
+        fprintf(stderr, "probeTransposition found nothing\n");
+    }
+    freeTranspositionTable(table);
+}
+
+/**
+ * @brief MCTS playouts from the first position of a game, one thread
+ *
+ * ns per playout (determinization, tree walk and random playout); the
+ * seed is picked so the first player has a choice to make.
+ */
+static void benchMcts(int packs)
+{
+    double samples[MAX_REPS];
+    long ops = packs >= 100 ? 200 : 5000;
+    MctsConfig config;
+    initMctsConfig(&config);
+    config.timeBudgetMs = 0;
+    config.maxIterations = (int)ops;
+    config.numThreads = 1;
+
+    GameState* game = NULL;
+    for (uint64_t seed = 8; game == NULL; seed++) {
+        game = initGameSeeded(packs, seed);
+        dealInitialCards(game);
+        int choices = 0;
+        for (int s = 0; s < NUM_SUITS; s++) {
+            for (int r = 0; r < NUM_RANKS; r++) {
+                Card card = { (Suit)s, (Rank)(r + TWO) };
+                choices += game->players[0].index.counts[s][r] > 0 && isValidMove(&card, &game->currentCard);
+            }
+        }
+        if (choices < 2) {
+            freeGame(game);
+            game = NULL;
+        }
+    }
+
+    GameView view;
+    initGameView(&view, game, 0);
+
+    for (int rep = -warmupReps; rep < timedReps; rep++) {
+        MctsStats stats;
+        double start = nowNs();
+        mctsSearch(&view, &config, (uint64_t)rep, &stats);
+        double elapsed = nowNs() - start;
+        if (rep >= 0) {
+            samples[rep] = elapsed / (double)stats.iterations;
+        }
+    }
+    report("mctsPlayout", packs, samples, timedReps, ops);
+
+    freeGame(game);
+}
+
+/**
+ * @brief Complete silent games, one after the other on one thread
+ *
+ * ns per game; games per second is 1e9 divided by it. With lazy set the
+ * hidden deck is a VirtualDeck, whose cost does not grow with packs.
+ */
+static void benchGames(const char* name, bool lazy, int packs)
+{
+    double samples[MAX_REPS];
+    long ops = 200;
+    GameConfig config;
+    initGameConfig(&config, packs, 0);
+    config.lazyHiddenDeck = lazy;
+
+    for (int rep = -warmupReps; rep < timedReps; rep++) {
+        double start = nowNs();
+        for (long i = 0; i < ops; i++) {
+            GameResult result;
+            playGameWithConfig(&config, &result);
+            config.seed++;
+        }
+        double elapsed = nowNs() - start;
+        if (rep >= 0) {
+            samples[rep] = elapsed / ops;
+        }
+    }
+    report(name, packs, samples, timedReps, ops);
+}
+
+/**
+ * @brief Complete games through the lockstep batch engine, one thread
+ *
+ * Same games as benchGames(), ns per game.
+ */
+static void benchBatchGames(int packs)
+{
+    double samples[MAX_REPS];
+    long ops = 20000;
+    unsigned long long seed = 0;
+    BatchEngine* engine = createBatchEngine(packs, NUM_PLAYERS, 0);
+
+    for (int rep = -warmupReps; rep < timedReps; rep++) {
+        BatchStats stats;
+        initBatchStats(&stats);
+        double start = nowNs();
+        runBatchGames(engine, seed, 0, ops, NULL, &stats);
+        double elapsed = nowNs() - start;
+        seed += (unsigned long long)ops;
+        if (rep >= 0) {
+            samples[rep] = elapsed / ops;
+        }
+    }
+    report("batchGames", packs, samples, timedReps, ops);
+
+    freeBatchEngine(engine);
+}
+
+int main(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--quick") == 0) {
+            warmupReps = 1;
+            timedReps = 5;
+        }
+        else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        }
+        else {
+            fprintf(stderr, "Usage: %s [--quick] [--filter NAME[,NAME...]]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    static const int packCounts[] = { 1, 10, 100, 1000 };
+    static const int packCountsCount = sizeof(packCounts) / sizeof(packCounts[0]);
+
+    printf("benchmark,param,backend,reps,ops_per_rep,min_ns,median_ns,mean_ns\n");
+
+    for (int i = 0; i < packCountsCount; i++) {
+        int packs = packCounts[i];
+
+        if (selected("initDeck")) benchInitDeck(packs);
+        if (selected("shuffleDeck")) benchShuffle(packs);
+        if (selected("shuffleDraw")) benchShuffleDraw("shuffleDraw", false, packs);
+        if (selected("shuffleLazyDraw")) benchShuffleDraw("shuffleLazyDraw", true, packs);
+        if (selected("sortDeck")) benchSort("sortDeck", sortDeck, packs);
+        if (selected("sortDeckWith")) benchSort("sortDeckWith", sortWithCompareCards, packs);
+        /// The old exchange sort is quadratic, keep it to sizes that finish
+        if (packs <= 10 && selected("exchangeSortDeck")) {
+            benchSort("exchangeSortDeck", exchangeSortDeck, packs);
+        }
+        if (packs <= 100 && selected("removeCardAt")) {
+            benchRemoveAt(packs, 0);
+            benchRemoveAt(packs, 50);
+            benchRemoveAt(packs, 100);
+        }
+        if (selected("insertCardSorted")) benchSortedInsert("insertCardSorted", true, packs);
+        if (selected("appendAndSort")) benchSortedInsert("appendAndSort", false, packs);
+        if (selected("reshuffleHiddenDeck")) benchReshuffle(packs);
+        if (selected("snapshotGame,restoreGame,copyGameSnapshot")) benchSnapshot(packs);
+        if (selected("rehashGame")) benchRehash(packs);
+        if (packs <= 100 && selected("playGame")) benchGames("playGame", false, packs);
+        if (selected("playGameLazy")) benchGames("playGameLazy", true, packs);
+        if (packs <= 100 && selected("mctsPlayout")) benchMcts(packs);
+        if (packs <= 100 && selected("batchGames")) benchBatchGames(packs);
+    }
+
+    /// Table sizes instead of pack counts: in cache and well out of it
+    if (selected("storeTransposition,probeTransposition")) {
+        benchTransposition(1L << 12);
+        benchTransposition(1L << 22);
+    }
+
+    return 0;
+}